@@ -69,6 +69,10 @@ if(WIN32)
         )
 endif()
 
+if(ENABLE_PROFILING AND ENABLE_TRACE_PROFILING)
+    message(FATAL_ERROR "ENABLE_PROFILING and ENABLE_TRACE_PROFILING can't be enabled together")
+endif()
+
 target_compile_definitions(rw_interface
     INTERFACE
         "$<$<CONFIG:Debug>:RW_DEBUG>"
@@ -77,6 +81,7 @@ target_compile_definitions(rw_interface
         "GLM_ENABLE_EXPERIMENTAL"
         "$<$<BOOL:${RW_VERBOSE_DEBUG_MESSAGES}>:RW_VERBOSE_DEBUG_MESSAGES>"
         "$<$<BOOL:${ENABLE_PROFILING}>:RW_PROFILER>"
+        "$<$<BOOL:${ENABLE_TRACE_PROFILING}>:RW_TRACE_PROFILER>"
     )
 
 if(CMAKE_SYSTEM_NAME STREQUAL "Linux")
@@ -126,6 +131,21 @@ if(ENABLE_SCRIPT_DEBUG)
     )
 endif()
 
+if(ENABLE_GRAPHICS_STATS)
+    target_compile_definitions(rw_interface
+        INTERFACE
+            "RW_GRAPHICS_STATS"
+    )
+endif()
+
+if(ENABLE_PHYSICS_MT)
+    target_compile_definitions(rw_interface
+        INTERFACE
+            "RW_PHYSICS_MT"
+            "BT_THREADSAFE=1"
+    )
+endif()
+
 if(FAILED_CHECK_ACTION STREQUAL "IGNORE")
     target_compile_definitions(rw_interface INTERFACE "RW_FAILED_CHECK_ACTION=0")
 elseif(FAILED_CHECK_ACTION STREQUAL "ABORT")
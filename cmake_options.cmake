@@ -6,6 +6,9 @@ option(BUILD_VIEWER "Build GUI data viewer")
 
 option(ENABLE_SCRIPT_DEBUG "Enable verbose script execution")
 option(ENABLE_PROFILING "Enable detailed profiling metrics")
+option(ENABLE_TRACE_PROFILING "Record profile scopes into a Chrome trace file")
+option(ENABLE_GRAPHICS_STATS "Collect GPU timings and draw statistics per render pass")
+option(ENABLE_PHYSICS_MT "Step physics on multiple threads (requires Bullet built with BT_THREADSAFE)")
 
 option(TEST_DATA "Enable tests that require game data")
 
@@ -14,6 +14,9 @@ Geometry::~Geometry() {
     if (EBO) {
         glDeleteBuffers(1, &EBO);
     }
+    if (sharedBuffer) {
+        sharedBuffer->free(allocation);
+    }
 }
 
 ModelFrame::ModelFrame(unsigned int index, glm::mat3 dR, glm::vec3 dT)
@@ -55,9 +58,9 @@ void ModelFrame::addChild(const ModelFramePtr& child) {
     child->updateHierarchyTransform();
 }
 
-ModelFrame* ModelFrame::findDescendant(const std::string& name) const {
+ModelFrame* ModelFrame::findDescendant(NameId name) const {
     for (const auto& frame : children_) {
-        if (frame->getName() == name) {
+        if (frame->getNameId() == name) {
             return frame.get();
         }
 
@@ -90,8 +93,8 @@ AtomicPtr Atomic::clone(const ModelFramePtr& newFrame) const {
     return newatomic;
 }
 
-ModelFrame* Clump::findFrame(const std::string& name) const {
-    if (rootframe_->getName() == name) {
+ModelFrame* Clump::findFrame(NameId name) const {
+    if (rootframe_->getNameId() == name) {
         return rootframe_.get();
     }
 
@@ -8,9 +8,11 @@
 
 #include <gl/DrawBuffer.hpp>
 #include <gl/GeometryBuffer.hpp>
+#include <gl/SharedGeometryBuffer.hpp>
 #include <gl/TextureData.hpp>
 #include <loaders/RWBinaryStream.hpp>
 
+#include <rw/StringId.hpp>
 #include <rw/forward.hpp>
 
 /**
@@ -24,6 +26,7 @@ class ModelFrame {
     glm::mat4 worldtransform_{1.0f};
     ModelFrame* parent_;
     std::string name;
+    NameId nameId;
     std::vector<ModelFramePtr> children_;
 
 public:
@@ -43,6 +46,7 @@ public:
 
     void setName(const std::string& fname) {
         name = fname;
+        nameId = NameId::intern(fname);
     }
 
     unsigned int getIndex() const {
@@ -95,7 +99,11 @@ public:
         return name;
     }
 
-    ModelFrame* findDescendant(const std::string& name) const;
+    NameId getNameId() const {
+        return nameId;
+    }
+
+    ModelFrame* findDescendant(NameId name) const;
 
     ModelFramePtr cloneHierarchy() const;
 };
@@ -136,6 +144,35 @@ struct GeometryVertex {
     GeometryVertex() = default;
 };
 
+/**
+ * Compact alternative to GeometryVertex
+ *
+ * Positions are quantized to 16 bits inside the geometry's bounding box and
+ * expanded by Geometry::positionTransform, normals are stored as
+ * GL_INT_2_10_10_10_REV and texture coordinates as half floats.
+ */
+struct PackedGeometryVertex {
+    glm::u16vec3 position{}; /* 0 */
+    uint16_t padding{};      /* 6 */
+    uint32_t normal{};       /* 8 */
+    uint32_t texcoord{};     /* 12 */
+    glm::u8vec4 colour{};    /* 16 */
+
+    /** @see GeometryBuffer */
+    static const AttributeList vertex_attributes() {
+        return {{ATRS_Position, 3, sizeof(PackedGeometryVertex), 0ul,
+                 GL_UNSIGNED_SHORT},
+                {ATRS_Normal, 4, sizeof(PackedGeometryVertex), 8ul,
+                 GL_INT_2_10_10_10_REV},
+                {ATRS_TexCoord, 2, sizeof(PackedGeometryVertex), 12ul,
+                 GL_HALF_FLOAT},
+                {ATRS_Colour, 4, sizeof(PackedGeometryVertex), 16ul,
+                 GL_UNSIGNED_BYTE}};
+    }
+};
+static_assert(sizeof(PackedGeometryVertex) == 20,
+              "PackedGeometryVertex should not contain padding");
+
 /**
  * Geometry
  */
@@ -172,8 +209,16 @@ struct Geometry {
 
     GLuint EBO;
 
+    /// Set when the vertex and index data live in a shared buffer
+    std::shared_ptr<SharedGeometryBuffer> sharedBuffer;
+    SharedGeometryBuffer::Allocation allocation;
+
     RW::BSGeometryBounds geometryBounds;
 
+    /// Maps quantized vertex positions back into model space
+    glm::mat4 positionTransform{1.0f};
+    bool quantizedPositions = false;
+
     uint32_t clumpNum;
 
     FaceType facetype;
@@ -185,6 +230,20 @@ struct Geometry {
 
     Geometry();
     ~Geometry();
+
+    DrawBuffer* getDrawBuffer() {
+        return sharedBuffer ? allocation.dbuff : &dbuff;
+    }
+
+    /// Offset of the first index within the draw buffer's indices
+    size_t getFirstIndex() const {
+        return allocation.firstIndex;
+    }
+
+    /// Offset added to each index within the draw buffer's vertices
+    size_t getBaseVertex() const {
+        return allocation.baseVertex;
+    }
 };
 
 /**
@@ -244,10 +303,10 @@ class Clump {
 public:
     /**
      * @brief findFrame Locates frame with name anywhere in the hierarchy
-     * @param name
+     * @param name, compared ignoring case
      * @return
      */
-    ModelFrame* findFrame(const std::string& name) const;
+    ModelFrame* findFrame(NameId name) const;
 
     ~Clump();
 
@@ -15,14 +15,18 @@ DrawBuffer::~DrawBuffer() {
 }
 
 void DrawBuffer::addGeometry(GeometryBuffer* gbuff) {
+    addGeometry(gbuff->getVBOName(), gbuff->getDataAttributes());
+}
+
+void DrawBuffer::addGeometry(GLuint vbo, const AttributeList& attributes) {
     if (vao == 0) {
         glGenVertexArrays(1, &vao);
     }
 
     glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, gbuff->getVBOName());
-    // Iterate the attributes present in the gbuff
-    for (const AttributeIndex& at : gbuff->getDataAttributes()) {
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    // Iterate the attributes present in the buffer
+    for (const AttributeIndex& at : attributes) {
         auto vaoindex = static_cast<GLuint>(at.sem);
         glEnableVertexAttribArray(vaoindex);
         glVertexAttribPointer(vaoindex, static_cast<GLint>(at.size), at.type, GL_TRUE, at.stride,
@@ -2,8 +2,7 @@
 #define _LIBRW_DRAWBUFFER_HPP_
 
 #include <gl/gl_core_3_3.h>
-
-class GeometryBuffer;
+#include <gl/GeometryBuffer.hpp>
 
 /**
  * DrawBuffer stores VAO state
@@ -32,6 +31,11 @@ public:
      * Adds a Geometry Buffer to the Draw Buffer.
      */
     void addGeometry(GeometryBuffer* gbuff);
+
+    /**
+     * Adds the attributes of a vertex buffer not owned by a GeometryBuffer.
+     */
+    void addGeometry(GLuint vbo, const AttributeList& attributes);
 };
 
 #endif
@@ -12,7 +12,9 @@ enum AttributeSemantic {
     ATRS_Position = 0,
     ATRS_Normal = 1,
     ATRS_Colour = 2,
-    ATRS_TexCoord = 3
+    ATRS_TexCoord = 3,
+    /// Per-instance model matrix, occupies 4 consecutive locations
+    ATRS_InstanceModel = 4
 };
 
 /**
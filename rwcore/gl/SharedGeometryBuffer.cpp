@@ -0,0 +1,189 @@
+#include "gl/SharedGeometryBuffer.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <utility>
+
+#include "rw/debug.hpp"
+
+BufferRangeAllocator::BufferRangeAllocator(size_t capacity)
+    : capacity(capacity) {
+    if (capacity > 0) {
+        freeRanges.emplace(0, capacity);
+    }
+}
+
+std::optional<size_t> BufferRangeAllocator::allocate(size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+
+    auto it = std::find_if(freeRanges.begin(), freeRanges.end(),
+                           [&](const auto& range) { return range.second >= size; });
+    if (it == freeRanges.end()) {
+        return std::nullopt;
+    }
+
+    const auto offset = it->first;
+    const auto remaining = it->second - size;
+    freeRanges.erase(it);
+    if (remaining > 0) {
+        freeRanges.emplace(offset + size, remaining);
+    }
+    return offset;
+}
+
+void BufferRangeAllocator::free(size_t offset, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    RW_ASSERT(offset + size <= capacity);
+
+    auto next = freeRanges.lower_bound(offset);
+    RW_ASSERT(next == freeRanges.end() || next->first >= offset + size);
+
+    // Merge with the following range
+    if (next != freeRanges.end() && next->first == offset + size) {
+        size += next->second;
+        next = freeRanges.erase(next);
+    }
+
+    // Merge with the preceding range
+    if (next != freeRanges.begin()) {
+        auto prev = std::prev(next);
+        RW_ASSERT(prev->first + prev->second <= offset);
+        if (prev->first + prev->second == offset) {
+            prev->second += size;
+            return;
+        }
+    }
+
+    freeRanges.emplace_hint(next, offset, size);
+}
+
+size_t BufferRangeAllocator::getFreeSize() const {
+    return std::accumulate(
+        freeRanges.begin(), freeRanges.end(), size_t{0u},
+        [](size_t a, const auto& range) { return a + range.second; });
+}
+
+size_t SharedGeometryBuffer::getBufferSize() const {
+    return std::accumulate(
+        pages.begin(), pages.end(), size_t{0u},
+        [&](size_t a, const auto& page) {
+            return a + page->vertices.getCapacity() * vertexSize +
+                   page->indices.getCapacity() * sizeof(uint32_t);
+        });
+}
+
+SharedGeometryBuffer::Page::~Page() {
+    if (ebo) {
+        glDeleteBuffers(1, &ebo);
+    }
+}
+
+SharedGeometryBuffer::SharedGeometryBuffer(AttributeList attributes,
+                                           size_t vertexSize,
+                                           size_t pageVertices,
+                                           size_t pageIndices)
+    : attributes(std::move(attributes))
+    , vertexSize(vertexSize)
+    , pageVertices(pageVertices)
+    , pageIndices(pageIndices) {
+}
+
+SharedGeometryBuffer::~SharedGeometryBuffer() = default;
+
+SharedGeometryBuffer::Page& SharedGeometryBuffer::createPage(
+    GLenum faceType, size_t numVertices, size_t numIndices) {
+    // Geometry larger than a page gets a page of its own
+    auto page = std::make_unique<Page>(std::max(numVertices, pageVertices),
+                                       std::max(numIndices, pageIndices));
+
+    page->gbuff.uploadVertices(
+        static_cast<GLsizei>(page->vertices.getCapacity()),
+        static_cast<GLsizeiptr>(page->vertices.getCapacity() * vertexSize),
+        nullptr);
+    page->gbuff.getDataAttributes() = attributes;
+    page->dbuff.setFaceType(faceType);
+    page->dbuff.addGeometry(&page->gbuff);
+
+    // The element buffer binding is stored in the VAO bound above
+    glGenBuffers(1, &page->ebo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, page->ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(page->indices.getCapacity() *
+                                         sizeof(uint32_t)),
+                 nullptr, GL_STATIC_DRAW);
+
+    pages.push_back(std::move(page));
+    return *pages.back();
+}
+
+SharedGeometryBuffer::Allocation SharedGeometryBuffer::allocate(
+    GLenum faceType, size_t numVertices, size_t vertexStride,
+    const void* vertices, size_t numIndices, const uint32_t* indices) {
+    RW_ASSERT(vertexStride == vertexSize);
+    RW_UNUSED(vertexStride);
+
+    Allocation allocation;
+    allocation.numVertices = numVertices;
+    allocation.numIndices = numIndices;
+
+    auto tryPage = [&](Page& page) {
+        if (page.dbuff.getFaceType() != faceType) {
+            return false;
+        }
+        auto vertexOffset = page.vertices.allocate(numVertices);
+        if (!vertexOffset) {
+            return false;
+        }
+        auto indexOffset = page.indices.allocate(numIndices);
+        if (!indexOffset) {
+            page.vertices.free(*vertexOffset, numVertices);
+            return false;
+        }
+        allocation.dbuff = &page.dbuff;
+        allocation.baseVertex = *vertexOffset;
+        allocation.firstIndex = *indexOffset;
+        return true;
+    };
+
+    for (auto p = 0u; p < pages.size() && !allocation.dbuff; ++p) {
+        if (tryPage(*pages[p])) {
+            allocation.page = p;
+        }
+    }
+
+    if (!allocation.dbuff) {
+        tryPage(createPage(faceType, numVertices, numIndices));
+        allocation.page = pages.size() - 1;
+    }
+
+    auto& page = *pages[allocation.page];
+
+    glBindBuffer(GL_ARRAY_BUFFER, page.gbuff.getVBOName());
+    glBufferSubData(GL_ARRAY_BUFFER,
+                    static_cast<GLintptr>(allocation.baseVertex * vertexSize),
+                    static_cast<GLsizeiptr>(numVertices * vertexSize),
+                    vertices);
+
+    glBindVertexArray(page.dbuff.getVAOName());
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER,
+                    static_cast<GLintptr>(allocation.firstIndex *
+                                          sizeof(uint32_t)),
+                    static_cast<GLsizeiptr>(numIndices * sizeof(uint32_t)),
+                    indices);
+
+    return allocation;
+}
+
+void SharedGeometryBuffer::free(const Allocation& allocation) {
+    if (!allocation.dbuff || allocation.page >= pages.size()) {
+        return;
+    }
+    auto& page = *pages[allocation.page];
+    page.vertices.free(allocation.baseVertex, allocation.numVertices);
+    page.indices.free(allocation.firstIndex, allocation.numIndices);
+}
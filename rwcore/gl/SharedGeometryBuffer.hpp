@@ -0,0 +1,128 @@
+#ifndef _LIBRW_SHAREDGEOMETRYBUFFER_HPP_
+#define _LIBRW_SHAREDGEOMETRYBUFFER_HPP_
+
+#include <gl/gl_core_3_3.h>
+#include <gl/DrawBuffer.hpp>
+#include <gl/GeometryBuffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/**
+ * First-fit allocator for ranges inside a buffer of fixed capacity
+ */
+class BufferRangeAllocator {
+    size_t capacity;
+    /// Free ranges, offset -> size
+    std::map<size_t, size_t> freeRanges;
+
+public:
+    explicit BufferRangeAllocator(size_t capacity);
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+    /**
+     * @return the offset of the allocated range, or nothing if there is no
+     * free range large enough
+     */
+    std::optional<size_t> allocate(size_t size);
+
+    /**
+     * Returns a range to the allocator, merging it with adjacent free ranges
+     */
+    void free(size_t offset, size_t size);
+
+    size_t getFreeSize() const;
+};
+
+/**
+ * SharedGeometryBuffer suballocates geometry of a single vertex format from
+ * a small number of large vertex and index buffers (pages). Every page has
+ * one DrawBuffer, geometry within a page is drawn by offsetting the first
+ * index and the base vertex.
+ */
+class SharedGeometryBuffer {
+public:
+    struct Allocation {
+        DrawBuffer* dbuff = nullptr;
+        size_t page = 0;
+        size_t baseVertex = 0;
+        size_t numVertices = 0;
+        size_t firstIndex = 0;
+        size_t numIndices = 0;
+    };
+
+    SharedGeometryBuffer(AttributeList attributes, size_t vertexSize,
+                         size_t pageVertices, size_t pageIndices);
+    ~SharedGeometryBuffer();
+
+    template <class T>
+    static std::shared_ptr<SharedGeometryBuffer> create(size_t pageVertices,
+                                                        size_t pageIndices) {
+        return std::make_shared<SharedGeometryBuffer>(
+            T::vertex_attributes(), sizeof(T), pageVertices, pageIndices);
+    }
+
+    /**
+     * Reserves space for the geometry in a page with the same face type
+     * and uploads the data. A new page is created if none has room.
+     */
+    template <class T>
+    Allocation allocate(GLenum faceType, const std::vector<T>& vertices,
+                        const std::vector<uint32_t>& indices) {
+        return allocate(faceType, vertices.size(), sizeof(T), vertices.data(),
+                        indices.size(), indices.data());
+    }
+
+    Allocation allocate(GLenum faceType, size_t numVertices,
+                        size_t vertexStride, const void* vertices,
+                        size_t numIndices, const uint32_t* indices);
+
+    /**
+     * Releases the space used by the allocation
+     */
+    void free(const Allocation& allocation);
+
+    size_t getPageCount() const {
+        return pages.size();
+    }
+
+    size_t getVertexSize() const {
+        return vertexSize;
+    }
+
+    /**
+     * @return bytes of vertex and index storage of all pages
+     */
+    size_t getBufferSize() const;
+
+private:
+    struct Page {
+        GeometryBuffer gbuff;
+        DrawBuffer dbuff;
+        GLuint ebo = 0;
+        BufferRangeAllocator vertices;
+        BufferRangeAllocator indices;
+
+        Page(size_t numVertices, size_t numIndices)
+            : vertices(numVertices), indices(numIndices) {
+        }
+        ~Page();
+    };
+
+    AttributeList attributes;
+    size_t vertexSize;
+    size_t pageVertices;
+    size_t pageIndices;
+    std::vector<std::unique_ptr<Page>> pages;
+
+    Page& createPage(GLenum faceType, size_t numVertices, size_t numIndices);
+};
+
+#endif
@@ -0,0 +1,135 @@
+#include "gl/StreamBuffer.hpp"
+
+#include <cstdint>
+
+#include "gl/DrawBuffer.hpp"
+#include "rw/debug.hpp"
+
+namespace {
+// How long to wait for a fence before asking again, in nanoseconds
+constexpr GLuint64 kFenceTimeout = 1000000;
+}  // namespace
+
+StreamRegionAllocator::StreamRegionAllocator(size_t capacity,
+                                             size_t regionCount)
+    : regionSize(capacity / regionCount), regionCount(regionCount) {
+    RW_ASSERT(regionCount > 0);
+}
+
+std::optional<size_t> StreamRegionAllocator::allocate(size_t size,
+                                                      size_t alignment) {
+    RW_ASSERT(alignment > 0);
+    const auto start = region * regionSize;
+    const auto offset =
+        (start + used + alignment - 1) / alignment * alignment;
+    if (offset + size > start + regionSize) {
+        return std::nullopt;
+    }
+    used = offset + size - start;
+    return offset;
+}
+
+size_t StreamRegionAllocator::advance() {
+    region = (region + 1) % regionCount;
+    used = 0;
+    return region;
+}
+
+StreamBuffer::StreamBuffer(size_t capacity)
+    : regions(capacity, kRegionCount) {
+    const auto size =
+        static_cast<GLsizeiptr>(regions.getRegionSize() * kRegionCount);
+
+    glGenBuffers(1, &vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (ogl_ext_ARB_buffer_storage) {
+        const GLbitfield flags =
+            GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+        mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    }
+}
+
+StreamBuffer::~StreamBuffer() {
+    for (auto fence : fences) {
+        if (fence) {
+            glDeleteSync(fence);
+        }
+    }
+    if (mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+    glDeleteBuffers(1, &vbo);
+}
+
+StreamBuffer::Allocation StreamBuffer::allocate(size_t count,
+                                                size_t stride) {
+    RW_ASSERT(count <= getMaxVertices(stride));
+    const auto size = count * stride;
+
+    auto offset = regions.allocate(size, stride);
+    if (!offset) {
+        advance();
+        offset = regions.allocate(size, stride);
+    }
+    RW_ASSERT(offset);
+
+    Allocation allocation;
+    allocation.offset = static_cast<GLintptr>(*offset);
+    allocation.baseVertex = *offset / stride;
+    allocation.count = count;
+
+    if (mapped) {
+        allocation.data = static_cast<uint8_t*>(mapped) + *offset;
+    } else if (size > 0) {
+        // The fences already keep the range out of use by the GPU
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        allocation.data = glMapBufferRange(
+            GL_ARRAY_BUFFER, allocation.offset,
+            static_cast<GLsizeiptr>(size),
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                GL_MAP_UNSYNCHRONIZED_BIT);
+    }
+    RW_ASSERT(allocation.data != nullptr || size == 0);
+    return allocation;
+}
+
+void StreamBuffer::commit(const Allocation& allocation) {
+    if (!mapped && allocation.data) {
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+}
+
+void StreamBuffer::bind(DrawBuffer& dbuff, const AttributeList& attributes) {
+    dbuff.addGeometry(vbo, attributes);
+}
+
+void StreamBuffer::nextFrame() {
+    if (!regions.isRegionEmpty()) {
+        advance();
+    }
+}
+
+void StreamBuffer::advance() {
+    fences[regions.getRegion()] =
+        glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    auto& fence = fences[regions.advance()];
+    if (!fence) {
+        return;
+    }
+    for (;;) {
+        const auto result =
+            glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, kFenceTimeout);
+        if (result != GL_TIMEOUT_EXPIRED) {
+            RW_CHECK(result != GL_WAIT_FAILED, "Stream buffer fence failed");
+            break;
+        }
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
@@ -0,0 +1,160 @@
+#ifndef _LIBRW_STREAMBUFFER_HPP_
+#define _LIBRW_STREAMBUFFER_HPP_
+
+#include <gl/gl_core_3_3.h>
+#include <gl/GeometryBuffer.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+
+class DrawBuffer;
+
+/**
+ * Hands out ranges of a buffer split into equal regions, one region is
+ * filled at a time.
+ */
+class StreamRegionAllocator {
+    size_t regionSize;
+    size_t regionCount;
+    size_t region = 0;
+    size_t used = 0;
+
+public:
+    StreamRegionAllocator(size_t capacity, size_t regionCount);
+
+    size_t getRegionSize() const {
+        return regionSize;
+    }
+
+    size_t getRegionCount() const {
+        return regionCount;
+    }
+
+    size_t getRegion() const {
+        return region;
+    }
+
+    bool isRegionEmpty() const {
+        return used == 0;
+    }
+
+    /**
+     * @return the most elements of the given stride that fit in any empty
+     * region, allowing for the padding that aligns the first one
+     */
+    size_t getMaxCount(size_t stride) const {
+        if (regionSize < stride) {
+            return 0;
+        }
+        return (regionSize - (stride - 1)) / stride;
+    }
+
+    /**
+     * @return the offset from the start of the buffer of a range in the
+     * current region, aligned to a multiple of alignment, or nothing if
+     * the rest of the region is too small
+     */
+    std::optional<size_t> allocate(size_t size, size_t alignment);
+
+    /**
+     * Moves on to the next region, wrapping around after the last
+     * @return the new region
+     */
+    size_t advance();
+};
+
+/**
+ * StreamBuffer is a vertex buffer for geometry that is rewritten every
+ * frame. Producers allocate the vertices they need, write them in place
+ * and draw from the returned base vertex.
+ *
+ * The buffer is split into kRegionCount regions, a frame writes into its
+ * own region and a fence is placed when the region is left. A region is
+ * only reused once its fence has signalled, so writes never wait on draws
+ * of the frames in flight. The buffer is persistently mapped when
+ * ARB_buffer_storage is available, otherwise each allocation maps its
+ * range unsynchronised.
+ *
+ * Only one allocation may be outstanding at a time.
+ */
+class StreamBuffer {
+public:
+    struct Allocation {
+        /// Where the vertices are written, valid until commit
+        void* data = nullptr;
+        /// Byte offset of the first vertex in the buffer
+        GLintptr offset = 0;
+        /// First vertex, for a DrawBuffer bound with bind
+        size_t baseVertex = 0;
+        size_t count = 0;
+    };
+
+    static constexpr size_t kRegionCount = 3;
+
+    explicit StreamBuffer(size_t capacity);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    GLuint getName() const {
+        return vbo;
+    }
+
+    bool isPersistent() const {
+        return mapped != nullptr;
+    }
+
+    /**
+     * @return the most vertices of the given stride a single allocation
+     * can hold
+     */
+    size_t getMaxVertices(size_t stride) const {
+        return regions.getMaxCount(stride);
+    }
+
+    /**
+     * Reserves count vertices, count must not exceed getMaxVertices.
+     * The offset is a multiple of the stride.
+     */
+    Allocation allocate(size_t count, size_t stride);
+
+    /**
+     * Makes the written vertices visible to draws
+     */
+    void commit(const Allocation& allocation);
+
+    template <class T>
+    Allocation upload(const T* vertices, size_t count) {
+        auto allocation = allocate(count, sizeof(T));
+        if (count > 0) {
+            std::memcpy(allocation.data, vertices, count * sizeof(T));
+        }
+        commit(allocation);
+        return allocation;
+    }
+
+    /**
+     * Points the attributes of the draw buffer at the start of the stream
+     * buffer, allocations of the same stride are then drawn from their
+     * base vertex.
+     */
+    void bind(DrawBuffer& dbuff, const AttributeList& attributes);
+
+    /**
+     * Called at the end of a frame, the next frame starts in a new region
+     */
+    void nextFrame();
+
+private:
+    GLuint vbo = 0;
+    void* mapped = nullptr;
+    StreamRegionAllocator regions;
+    std::array<GLsync, kRegionCount> fences{};
+
+    void advance();
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <gl/gl_core_3_3.h>
 #include <glm/vec2.hpp>
+#include <rw/StringId.hpp>
 
 #include <memory>
 #include <string>
@@ -43,6 +44,6 @@ private:
     glm::ivec2 size;
     bool hasAlpha;
 };
-using TextureArchive = std::unordered_map<std::string, std::unique_ptr<TextureData>>;
+using TextureArchive = std::unordered_map<NameId, std::unique_ptr<TextureData>>;
 
 #endif
@@ -5,10 +5,13 @@
 #include <cstdint>
 #include <cstring>
 #include <cstdlib>
+#include <limits>
 #include <memory>
 #include <numeric>
 
 #include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 
 #include "data/Clump.hpp"
 #include "gl/gl_core_3_3.h"
@@ -249,26 +252,83 @@ GeometryPtr LoaderDFF::readGeometry(const RWBStream &stream) {
         }
     }
 
-    geom->dbuff.setFaceType(geom->facetype == Geometry::Triangles
-                                ? GL_TRIANGLES
-                                : GL_TRIANGLE_STRIP);
-    geom->gbuff.uploadVertices(verts);
-    geom->dbuff.addGeometry(&geom->gbuff);
+    if (vertexFormat == VertexFormat::Packed) {
+        uploadGeometry(*geom, packVertices(*geom, verts));
+    } else {
+        uploadGeometry(*geom, verts);
+    }
 
-    glGenBuffers(1, &geom->EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geom->EBO);
+    return geom;
+}
+
+std::vector<PackedGeometryVertex> LoaderDFF::packVertices(
+    Geometry &geom, const std::vector<GeometryVertex> &verts) {
+    glm::vec3 min{std::numeric_limits<float>::max()};
+    glm::vec3 max{std::numeric_limits<float>::lowest()};
+    for (const auto &v : verts) {
+        min = glm::min(min, v.position);
+        max = glm::max(max, v.position);
+    }
+    if (verts.empty()) {
+        min = max = glm::vec3{};
+    }
+
+    const auto extent = max - min;
+    const auto quantize =
+        65535.f /
+        glm::max(extent, glm::vec3{std::numeric_limits<float>::epsilon()});
+
+    std::vector<PackedGeometryVertex> packed(verts.size());
+    for (size_t v = 0; v < verts.size(); ++v) {
+        const auto &in = verts[v];
+        auto &out = packed[v];
+        out.position = glm::u16vec3(
+            glm::round(glm::clamp((in.position - min) * quantize, 0.f, 65535.f)));
+        out.normal = glm::packSnorm3x10_1x2(glm::vec4(in.normal, 0.f));
+        out.texcoord = glm::packHalf2x16(in.texcoord);
+        out.colour = in.colour;
+    }
+
+    // DrawBuffer reads the positions normalized into [0, 1]
+    geom.positionTransform =
+        glm::scale(glm::translate(glm::mat4(1.f), min), extent);
+    geom.quantizedPositions = true;
+
+    return packed;
+}
+
+template <class T>
+void LoaderDFF::uploadGeometry(Geometry &geom, const std::vector<T> &verts) {
+    const GLenum faceType =
+        geom.facetype == Geometry::Triangles ? GL_TRIANGLES : GL_TRIANGLE_STRIP;
+
+    if (geometryBuffer) {
+        std::vector<uint32_t> indices;
+        for (const auto &sg : geom.subgeom) {
+            indices.insert(indices.end(), sg.indices.begin(), sg.indices.end());
+        }
+
+        geom.sharedBuffer = geometryBuffer;
+        geom.allocation = geometryBuffer->allocate(faceType, verts, indices);
+        return;
+    }
+
+    geom.dbuff.setFaceType(faceType);
+    geom.gbuff.uploadVertices(verts);
+    geom.dbuff.addGeometry(&geom.gbuff);
+
+    glGenBuffers(1, &geom.EBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geom.EBO);
 
     size_t icount = std::accumulate(
-        geom->subgeom.begin(), geom->subgeom.end(), size_t{0u},
+        geom.subgeom.begin(), geom.subgeom.end(), size_t{0u},
         [](size_t a, const SubGeometry &b) { return a + b.numIndices; });
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t) * icount, nullptr,
                  GL_STATIC_DRAW);
-    for (auto &sg : geom->subgeom) {
+    for (auto &sg : geom.subgeom) {
         glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, sg.start * sizeof(uint32_t),
                         sizeof(uint32_t) * sg.numIndices, sg.indices.data());
     }
-
-    return geom;
 }
 
 void LoaderDFF::readMaterialList(const GeometryPtr &geom, const RWBStream &stream) {
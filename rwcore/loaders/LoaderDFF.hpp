@@ -5,6 +5,7 @@
 #include <rw/forward.hpp>
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -30,14 +31,51 @@ public:
     using GeometryList = std::vector<GeometryPtr>;
     using FrameList = std::vector<ModelFramePtr>;
 
+    enum class VertexFormat {
+        /// GeometryVertex
+        Full,
+        /// PackedGeometryVertex, with quantized positions
+        Packed
+    };
+
     ClumpPtr loadFromMemory(const FileContentsInfo& file);
 
     void setTextureLookupCallback(const TextureLookupCallback& tlc) {
         textureLookup = tlc;
     }
 
+    /**
+     * Geometry is suballocated from the shared buffer when one is set,
+     * otherwise each geometry gets buffers of its own.
+     */
+    void setGeometryBuffer(const std::shared_ptr<SharedGeometryBuffer>& buffer) {
+        geometryBuffer = buffer;
+    }
+
+    const std::shared_ptr<SharedGeometryBuffer>& getGeometryBuffer() const {
+        return geometryBuffer;
+    }
+
+    /**
+     * The geometry buffer, if any, must have been created for the
+     * matching vertex type.
+     */
+    void setVertexFormat(VertexFormat format) {
+        vertexFormat = format;
+    }
+
+    /**
+     * Quantizes vertices into PackedGeometryVertex, setting up the
+     * geometry's position transform. The positions are read normalized,
+     * so the transform maps [0, 1] onto the bounding box.
+     */
+    static std::vector<PackedGeometryVertex> packVertices(
+        Geometry& geom, const std::vector<GeometryVertex>& verts);
+
 private:
     TextureLookupCallback textureLookup;
+    std::shared_ptr<SharedGeometryBuffer> geometryBuffer;
+    VertexFormat vertexFormat = VertexFormat::Full;
 
     FrameList readFrameList(const RWBStream& stream);
 
@@ -45,6 +83,13 @@ private:
 
     GeometryPtr readGeometry(const RWBStream& stream);
 
+    /**
+     * Uploads vertices and subgeometry indices, into the shared geometry
+     * buffer if there is one
+     */
+    template <class T>
+    void uploadGeometry(Geometry& geom, const std::vector<T>& verts);
+
     void readMaterialList(const GeometryPtr& geom, const RWBStream& stream);
 
     void readMaterial(const GeometryPtr& geom, const RWBStream& stream);
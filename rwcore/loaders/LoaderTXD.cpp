@@ -192,7 +192,8 @@ bool TextureLoader::loadFromMemory(const FileContentsInfo& file,
         std::transform(name.begin(), name.end(), name.begin(), ::tolower);
         std::transform(alpha.begin(), alpha.end(), alpha.begin(), ::tolower);
 
-        inTextures[name] = createTexture(texNative, rootSection);
+        inTextures[NameId::intern(name)] =
+            createTexture(texNative, rootSection);
     }
 
     return true;
@@ -0,0 +1,77 @@
+#include "rw/StringId.hpp"
+
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#include "rw/debug.hpp"
+
+namespace {
+/// Strings that have been interned, by ID, one table per case mode
+struct Registry {
+    std::mutex mutex;
+    std::unordered_map<uint64_t, std::string> strings;
+};
+
+template <StringCase Case>
+Registry& registry() {
+    // Leaked so IDs can still be printed during static destruction
+    static auto instance = new Registry;
+    return *instance;
+}
+
+[[maybe_unused]] bool sameString(StringCase mode, std::string_view a,
+                                 std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        auto ca = a[i];
+        auto cb = b[i];
+        if (mode == StringCase::Insensitive) {
+            ca = (ca >= 'A' && ca <= 'Z') ? static_cast<char>(ca - 'A' + 'a')
+                                          : ca;
+            cb = (cb >= 'A' && cb <= 'Z') ? static_cast<char>(cb - 'A' + 'a')
+                                          : cb;
+        }
+        if (ca != cb) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+template <StringCase Case>
+BasicStringId<Case> BasicStringId<Case>::intern(std::string_view string) {
+    BasicStringId id(string);
+
+    auto& r = registry<Case>();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto [it, inserted] = r.strings.try_emplace(id.value, string);
+    RW_CHECK(inserted || sameString(Case, it->second, string),
+             "String ID collision between " << it->second << " and "
+                                            << string);
+    RW_UNUSED(inserted);
+    return id;
+}
+
+template <StringCase Case>
+std::string BasicStringId<Case>::str() const {
+    {
+        auto& r = registry<Case>();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto it = r.strings.find(value);
+        if (it != r.strings.end()) {
+            return it->second;
+        }
+    }
+
+    std::ostringstream ss;
+    ss << '#' << std::hex << std::setw(16) << std::setfill('0') << value;
+    return ss.str();
+}
+
+template class BasicStringId<StringCase::Sensitive>;
+template class BasicStringId<StringCase::Insensitive>;
@@ -0,0 +1,106 @@
+#ifndef _LIBRW_STRINGID_HPP_
+#define _LIBRW_STRINGID_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+enum class StringCase { Sensitive, Insensitive };
+
+/**
+ * Identifies a string by its 64 bit FNV-1a hash, so it is compared and
+ * hashed as an integer. Literals are hashed at compile time, other strings
+ * are hashed without being copied.
+ *
+ * The string behind an ID is only known once it has been interned, intern
+ * is called where names are loaded so that str() can be used when
+ * debugging. Strings don't convert implicitly, so that hashing them stays
+ * visible and IDs used every frame are kept from load time. Case
+ * insensitive IDs fold ASCII letters to lower case before hashing.
+ */
+template <StringCase Case>
+class BasicStringId {
+public:
+    constexpr BasicStringId() = default;
+
+    constexpr explicit BasicStringId(const char* string)
+        : value(hash(std::string_view(string))) {
+    }
+
+    explicit BasicStringId(const std::string& string)
+        : value(hash(string)) {
+    }
+
+    constexpr explicit BasicStringId(std::string_view string)
+        : value(hash(string)) {
+    }
+
+    /**
+     * @return the ID of string, remembering the string for str()
+     */
+    static BasicStringId intern(std::string_view string);
+
+    static constexpr uint64_t hash(std::string_view string) {
+        uint64_t h = 14695981039346656037ull;
+        for (auto c : string) {
+            if constexpr (Case == StringCase::Insensitive) {
+                c = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a')
+                                           : c;
+            }
+            h ^= static_cast<uint8_t>(c);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    constexpr uint64_t getValue() const {
+        return value;
+    }
+
+    /**
+     * @return the interned string, or the hash in hex if it was never
+     * interned
+     */
+    std::string str() const;
+
+    constexpr bool operator==(const BasicStringId& other) const {
+        return value == other.value;
+    }
+
+    constexpr bool operator!=(const BasicStringId& other) const {
+        return value != other.value;
+    }
+
+    constexpr bool operator<(const BasicStringId& other) const {
+        return value < other.value;
+    }
+
+private:
+    uint64_t value = hash({});
+};
+
+/// For engine identifiers, such as activity and sound names
+using StringId = BasicStringId<StringCase::Sensitive>;
+/// For names from the game data, which is not consistent in its case
+using NameId = BasicStringId<StringCase::Insensitive>;
+
+constexpr StringId operator""_sid(const char* string, size_t length) {
+    return StringId(std::string_view(string, length));
+}
+
+constexpr NameId operator""_nid(const char* string, size_t length) {
+    return NameId(std::string_view(string, length));
+}
+
+namespace std {
+template <StringCase Case>
+struct hash<BasicStringId<Case>> {
+    size_t operator()(const BasicStringId<Case>& id) const {
+        return static_cast<size_t>(id.getValue());
+    }
+};
+}  // namespace std
+
+#endif
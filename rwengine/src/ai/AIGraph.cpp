@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <limits>
 
 #include <glm/gtx/norm.hpp>
 
@@ -13,6 +14,49 @@
 
 namespace ai {
 
+namespace {
+/// External nodes closer than this are merged
+constexpr float kExternalMergeDistance = 1.f;
+
+glm::ivec3 mergeCell(const glm::vec3& position) {
+    return glm::ivec3(glm::floor(position / kExternalMergeDistance));
+}
+
+std::uint64_t cellKey(const glm::ivec3& cell) {
+    constexpr std::uint64_t kMask = (1u << 21) - 1;
+    return (static_cast<std::uint64_t>(cell.x) & kMask) |
+           ((static_cast<std::uint64_t>(cell.y) & kMask) << 21) |
+           ((static_cast<std::uint64_t>(cell.z) & kMask) << 42);
+}
+}  // namespace
+
+AIGraphNode* AIGraph::findExternalNode(const glm::vec3& position) const {
+    // Nodes in range lie in the neighbouring cells. The oldest one wins, as
+    // it would when searching externalNodes in order.
+    const auto cell = mergeCell(position);
+    auto best = std::numeric_limits<std::uint32_t>::max();
+    for (int x = -1; x <= 1; ++x) {
+        for (int y = -1; y <= 1; ++y) {
+            for (int z = -1; z <= 1; ++z) {
+                auto it = externalNodeCells.find(
+                    cellKey(cell + glm::ivec3(x, y, z)));
+                if (it == externalNodeCells.end()) {
+                    continue;
+                }
+                for (auto index : it->second) {
+                    if (index < best &&
+                        glm::distance2(externalNodes[index]->position,
+                                       position) <
+                            kExternalMergeDistance * kExternalMergeDistance) {
+                        best = index;
+                    }
+                }
+            }
+        }
+    }
+    return best < externalNodes.size() ? externalNodes[best] : nullptr;
+}
+
 void AIGraph::createPathNodes(const glm::vec3& position,
                               const glm::quat& rotation, PathData& path) {
     auto startIndex = static_cast<std::uint32_t>(nodes.size());
@@ -26,13 +70,9 @@ void AIGraph::createPathNodes(const glm::vec3& position,
         glm::vec3 nodePosition = position + (rotation * node.position);
 
         if (node.type == PathNode::EXTERNAL) {
-            for (auto& realNode : externalNodes) {
-                auto d = glm::distance2(realNode->position, nodePosition);
-                if (d < 1.f) {
-                    pathNodes.push_back(realNode);
-                    external = true;
-                    break;
-                }
+            if (auto realNode = findExternalNode(nodePosition)) {
+                pathNodes.push_back(realNode);
+                external = true;
             }
         }
         if (!external) {
@@ -55,6 +95,8 @@ void AIGraph::createPathNodes(const glm::vec3& position,
             nodes.push_back(std::move(ainode));
 
             if (ptr->external) {
+                externalNodeCells[cellKey(mergeCell(ptr->position))].push_back(
+                    static_cast<std::uint32_t>(externalNodes.size()));
                 externalNodes.push_back(ptr);
 
                 // Determine which grid cell this node falls into
@@ -86,6 +128,8 @@ void AIGraph::createPathNodes(const glm::vec3& position,
             next->connections.push_back(node);
         }
     }
+
+    revision++;
 }
 
 glm::ivec2 worldToGrid(const glm::vec2& world) {
@@ -96,7 +140,7 @@ glm::ivec2 worldToGrid(const glm::vec2& world) {
 
 void AIGraph::gatherExternalNodesNear(const glm::vec3& center,
                                       const float radius,
-                                      std::vector<AIGraphNode*>& nodes,
+                                      std::pmr::vector<AIGraphNode*>& nodes,
                                       NodeType type) {
     // the bounds end up covering more than might fit
     auto planecoords = glm::vec2(center);
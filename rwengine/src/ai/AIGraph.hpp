@@ -6,6 +6,8 @@
 #include <rw/types.hpp>
 
 #include <array>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 struct PathData;
@@ -33,11 +35,28 @@ public:
      */
     std::array<std::vector<AIGraphNode*>, WORLD_GRID_CELLS> gridNodes;
 
+    /**
+     * Incremented whenever nodes or connections are added, so that copies
+     * of the graph can tell they are out of date
+     */
+    std::uint64_t revision = 0;
+
     void createPathNodes(const glm::vec3& position, const glm::quat& rotation,
                          PathData& path);
 
     void gatherExternalNodesNear(const glm::vec3& center, const float radius,
-                                 std::vector<AIGraphNode*>& nodes, NodeType type);
+                                 std::pmr::vector<AIGraphNode*>& nodes,
+                                 NodeType type);
+
+private:
+    /**
+     * Indices into externalNodes by unit cell, used to find the external
+     * node a new path joins
+     */
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>>
+        externalNodeCells;
+
+    AIGraphNode* findExternalNode(const glm::vec3& position) const;
 };
 
 } // ai
@@ -0,0 +1,74 @@
+#include "ai/AIScheduler.hpp"
+
+#include <glm/gtx/norm.hpp>
+
+namespace {
+constexpr float kFullRateRadius = 30.f;
+constexpr float kVisibleRadius = 100.f;
+constexpr float kNearRadius = 60.f;
+constexpr float kFarRadius = 150.f;
+/// Radius used to test characters against the view frustum
+constexpr float kVisibilityRadius = 2.f;
+
+constexpr uint32_t kVisibleInterval = 2;
+constexpr uint32_t kNearInterval = 4;
+constexpr uint32_t kFarInterval = 8;
+}  // namespace
+
+namespace ai {
+
+void AIScheduler::beginTick(const glm::vec3& position,
+                            const ViewFrustum& view) {
+    focus = position;
+    frustum = view;
+    ++tick;
+}
+
+void AIScheduler::reset() {
+    frustum.reset();
+}
+
+uint32_t AIScheduler::getInterval(const glm::vec3& position) const {
+    if (!frustum) {
+        return 1;
+    }
+
+    const auto distance2 = glm::distance2(position, focus);
+    if (distance2 < kFullRateRadius * kFullRateRadius) {
+        return 1;
+    }
+
+    if (distance2 < kVisibleRadius * kVisibleRadius &&
+        frustum->intersects(position, kVisibilityRadius)) {
+        return distance2 < kNearRadius * kNearRadius ? 1 : kVisibleInterval;
+    }
+
+    if (distance2 < kNearRadius * kNearRadius) {
+        return kNearInterval;
+    }
+    if (distance2 < kFarRadius * kFarRadius) {
+        return kFarInterval;
+    }
+    return kDormant;
+}
+
+bool AIScheduler::schedule(Slot& slot, uint32_t id, const glm::vec3& position,
+                           float tickDt, float& dt) const {
+    const auto interval = getInterval(position);
+    if (interval == kDormant) {
+        // Dormant controllers start afresh when they wake up
+        slot.pendingTime = 0.f;
+        return false;
+    }
+
+    slot.pendingTime += tickDt;
+    if ((tick + id) % interval != 0) {
+        return false;
+    }
+
+    dt = slot.pendingTime;
+    slot.pendingTime = 0.f;
+    return true;
+}
+
+}  // namespace ai
@@ -0,0 +1,65 @@
+#ifndef _RWENGINE_AISCHEDULER_HPP_
+#define _RWENGINE_AISCHEDULER_HPP_
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <optional>
+
+#include <render/ViewFrustum.hpp>
+
+namespace ai {
+
+/**
+ * @brief Decides how often AI controllers are updated
+ *
+ * Controllers near the focus or in view are updated every tick, others
+ * every few ticks and distant ones not at all. Controllers sharing an
+ * interval are spread over the ticks by their object ID, so the cost of
+ * each tier is the same every tick. Skipped time is handed to the
+ * controller with its next update.
+ */
+class AIScheduler {
+public:
+    /**
+     * Per-controller scheduling state
+     */
+    struct Slot {
+        /// Time since the last update
+        float pendingTime = 0.f;
+    };
+
+    /// Update interval of controllers that are not updated at all
+    static constexpr uint32_t kDormant = 0;
+
+    /**
+     * Starts a new tick, controllers are scheduled relative to focus
+     */
+    void beginTick(const glm::vec3& focus, const ViewFrustum& frustum);
+
+    /**
+     * Stops time slicing, all controllers update every tick
+     */
+    void reset();
+
+    /**
+     * @return the number of ticks between updates at position, or kDormant
+     */
+    uint32_t getInterval(const glm::vec3& position) const;
+
+    /**
+     * @param dt Set to the time to update the controller with
+     * @return true if the controller should be updated this tick
+     */
+    bool schedule(Slot& slot, uint32_t id, const glm::vec3& position,
+                  float tickDt, float& dt) const;
+
+private:
+    std::optional<ViewFrustum> frustum;
+    glm::vec3 focus{};
+    uint64_t tick = 0;
+};
+
+}  // namespace ai
+
+#endif
@@ -1,7 +1,9 @@
 #include "ai/CharacterController.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <mutex>
 #include <utility>
 
 #ifdef _MSC_VER
@@ -27,6 +29,7 @@
 #include "engine/Animator.hpp"
 #include "engine/GameData.hpp"
 #include "engine/GameWorld.hpp"
+#include "engine/TickCommands.hpp"
 #include "items/Weapon.hpp"
 #include "objects/CharacterObject.hpp"
 #include "objects/VehicleObject.hpp"
@@ -65,9 +68,9 @@ void CharacterController::setNextActivity(std::unique_ptr<Activity> activity) {
     }
 }
 
-bool CharacterController::isCurrentActivity(const std::string &activity) const {
+bool CharacterController::isCurrentActivity(StringId activity) const {
     if (getCurrentActivity() == nullptr) return false;
-    return getCurrentActivity()->name() == activity;
+    return getCurrentActivity()->id() == activity;
 }
 
 void CharacterController::update(float dt) {
@@ -132,6 +135,33 @@ void CharacterController::setRunning(bool run) {
     character->setRunning(run);
 }
 
+AIGraphNode* CharacterController::nextNodeTowardsDestination(
+    AIGraphNode* node) {
+    if (!m_hasDestination || node == nullptr) {
+        return nullptr;
+    }
+
+    auto route = character->engine->routePlanner.findRoute(
+        node, findDestinationNode(node->type));
+    if (!route || route->nodes.size() < 2) {
+        return nullptr;
+    }
+    return route->nodes[1];
+}
+
+bool CharacterController::reachedDestination(AIGraphNode* node) {
+    return m_hasDestination && node != nullptr &&
+           findDestinationNode(node->type) == node;
+}
+
+AIGraphNode* CharacterController::findDestinationNode(NodeType type) {
+    if (m_destinationNode == nullptr) {
+        m_destinationNode = character->engine->routePlanner.findNearestNode(
+            m_destination, type);
+    }
+    return m_destinationNode;
+}
+
 bool Activities::GoTo::update(CharacterObject *character,
                               CharacterController *controller) {
     /* TODO: Use the ai nodes to navigate to the position */
@@ -210,9 +240,13 @@ bool CharacterController::checkForObstacles() {
     auto[center, halfSize] = vehicle->obstacleCheckVolume();
     const auto rotation = vehicle->getRotation();
     center = vehicle->getPosition() + rotation * center;
-    auto results = test.boxTest(center, halfSize, vehicle->getRotation());
+    {
+        // Vehicles may be driven by controllers thinking in parallel
+        std::lock_guard<std::mutex> lock(vehicle->engine->physicsQueryMutex);
+        test.boxTest(center, halfSize, rotation, obstacleHits);
+    }
 
-    return any_of(results.begin(), results.end(),
+    return any_of(obstacleHits.begin(), obstacleHits.end(),
                   [&](const auto &hit) {
                       return !(hit.object == vehicle ||
                                hit.body->isStaticObject());
@@ -238,7 +272,10 @@ bool Activities::DriveTo::update(CharacterObject *character,
     glm::vec3 roadTarget;
 
     // A list of nodes we can choose from
-    std::vector<AIGraphNode*> potentialNodes = targetNode->connections;
+    const auto& connections = targetNode->connections;
+    std::pmr::vector<AIGraphNode*> potentialNodes(
+        connections.begin(), connections.end(),
+        &character->engine->getTickArena());
 
     // Make sure that we have a lastTargetNode
     if (lastTargetNode == nullptr) {
@@ -279,7 +316,16 @@ bool Activities::DriveTo::update(CharacterObject *character,
     }
     // Intersection, choose a direction
     else if (potentialNodes.size() > 1) {
-        // Choose the next node randomly
+        // Head towards the destination, if there is one
+        if (nextTargetNode == nullptr) {
+            auto node = controller->nextNodeTowardsDestination(targetNode);
+            if (std::find(potentialNodes.begin(), potentialNodes.end(),
+                          node) != potentialNodes.end()) {
+                nextTargetNode = node;
+            }
+        }
+
+        // Otherwise choose the next node randomly
         if(nextTargetNode == nullptr) {
             auto i = character->engine->getRandomNumber(
                 0u, potentialNodes.size() - 1);
@@ -349,6 +395,9 @@ bool Activities::DriveTo::update(CharacterObject *character,
         vehicle->setHandbraking(true);
     }
 
+    // Distant vehicles follow the road target directly
+    vehicle->setPathTarget(roadTarget, currentSpeed);
+
     // Steer to the target
     controller->steerTo(roadTarget);
 
@@ -489,12 +538,18 @@ bool Activities::EnterVehicle::update(CharacterObject *character,
             // out.
             character->playCycle(cycle_pullout);
 
-            if (currentOccupant->controller->getCurrentActivity() != nullptr) {
-                currentOccupant->controller->skipActivity();
-            }
+            auto exit = std::make_unique<Activities::ExitVehicle>(true);
+            if (auto commands = TickCommands::current()) {
+                commands->setActivity(currentOccupant->controller,
+                                      std::move(exit));
+            } else {
+                if (currentOccupant->controller->getCurrentActivity() !=
+                    nullptr) {
+                    currentOccupant->controller->skipActivity();
+                }
 
-            currentOccupant->controller->setNextActivity(
-                std::make_unique<Activities::ExitVehicle>(true));
+                currentOccupant->controller->setNextActivity(std::move(exit));
+            }
         } else {
             character->playCycle(cycle_enter);
             character->enterVehicle(vehicle, seat);
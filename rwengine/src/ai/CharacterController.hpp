@@ -7,11 +7,16 @@
 #include <memory>
 #include <string>
 
+#include <ai/AIScheduler.hpp>
+#include <dynamics/HitTest.hpp>
+#include <rw/StringId.hpp>
+
 class CharacterObject;
 class VehicleObject;
 
 namespace ai {
 
+enum class NodeType;
 struct AIGraphNode;
 
 /**
@@ -29,6 +34,9 @@ public:
 
         virtual std::string name() const = 0;
 
+        /// Compared instead of the name when checking the current activity
+        virtual StringId id() const = 0;
+
         /**
          * @brief canSkip
          * @return true if the activity can be skipped.
@@ -37,6 +45,14 @@ public:
             return false;
         }
 
+        /**
+         * @return true if the activity changes objects other than the
+         * character, such as the vehicle being entered
+         */
+        virtual bool changesOtherObjects() const {
+            return false;
+        }
+
         virtual bool update(CharacterObject* character,
                             CharacterController* controller) = 0;
     };
@@ -75,10 +91,21 @@ protected:
     // When driving a vehicle 
     int m_lane;
 
+    // Reused by checkForObstacles
+    HitTest::TestResult obstacleHits;
+
     // Goal related variables
     Goal currentGoal{None};
     CharacterObject* leader = nullptr;
 
+    // Where traffic drivers are heading, if anywhere
+    bool m_hasDestination = false;
+    glm::vec3 m_destination{};
+    AIGraphNode* m_destinationNode = nullptr;
+
+    /// The node of the given type closest to the destination
+    AIGraphNode* findDestinationNode(NodeType type);
+
 public:
     /**
      * The character being controlled.
@@ -89,6 +116,11 @@ public:
     AIGraphNode* lastTargetNode;
     AIGraphNode* nextTargetNode;
 
+    /**
+     * Time slicing state, see AIScheduler
+     */
+    AIScheduler::Slot scheduleSlot;
+
     CharacterController() = default;
 
     virtual ~CharacterController() = default;
@@ -125,10 +157,10 @@ public:
 
     /**
      * @brief IsCurrentActivity
-     * @param activity Name of activity to check for
+     * @param activity ID of activity to check for, e.g. ActivityId
      * @return if the given activity is the current activity
      */
-    bool isCurrentActivity(const std::string& activity) const;
+    bool isCurrentActivity(StringId activity) const;
 
     /**
      * @brief update Updates the controller.
@@ -136,6 +168,15 @@ public:
      */
     virtual void update(float dt);
 
+    /**
+     * @brief canThinkInParallel
+     * @return true if the next update only changes the character and the
+     * vehicle it is driving, so it may run alongside other characters.
+     */
+    virtual bool canThinkInParallel() const {
+        return false;
+    }
+
     virtual glm::vec3 getTargetPosition() = 0;
 
     /**
@@ -180,6 +221,38 @@ public:
         return currentGoal;
     }
 
+    /**
+     * @brief setDestination Makes drivers follow the route to the position
+     * at intersections instead of turning randomly
+     */
+    void setDestination(const glm::vec3& position) {
+        m_hasDestination = true;
+        m_destination = position;
+        m_destinationNode = nullptr;
+    }
+
+    void clearDestination() {
+        m_hasDestination = false;
+        m_destinationNode = nullptr;
+    }
+
+    bool hasDestination() const {
+        return m_hasDestination;
+    }
+
+    /**
+     * @brief nextNodeTowardsDestination
+     * @return the node following node on the route to the destination, or
+     * nullptr if there is no destination or node is already the closest
+     */
+    AIGraphNode* nextNodeTowardsDestination(AIGraphNode* node);
+
+    /**
+     * @brief reachedDestination
+     * @return true if node is the closest node to the destination
+     */
+    bool reachedDestination(AIGraphNode* node);
+
     void setTargetCharacter(CharacterObject* c) {
         leader = c;
     }
@@ -190,10 +263,14 @@ public:
     friend class CharacterObject;
 };
 
-#define DECL_ACTIVITY(activity_name)                     \
-    static constexpr auto ActivityName = #activity_name; \
-    std::string name() const override {                  \
-        return ActivityName;                             \
+#define DECL_ACTIVITY(activity_name)                          \
+    static constexpr auto ActivityName = #activity_name;      \
+    static constexpr StringId ActivityId{#activity_name};     \
+    std::string name() const override {                       \
+        return ActivityName;                                  \
+    }                                                         \
+    StringId id() const override {                            \
+        return ActivityId;                                    \
     }
 
 // TODO: Refactor this with an ugly macro to reduce code dup.
@@ -270,6 +347,10 @@ struct EnterVehicle : public CharacterController::Activity {
     bool canSkip(CharacterObject* character,
                  CharacterController*) const override;
 
+    bool changesOtherObjects() const override {
+        return true;
+    }
+
     bool update(CharacterObject* character, CharacterController* controller) override;
 };
 
@@ -281,6 +362,10 @@ struct ExitVehicle : public CharacterController::Activity {
     ExitVehicle(bool jacked_ = false) : jacked(jacked_) {
     }
 
+    bool changesOtherObjects() const override {
+        return true;
+    }
+
     bool update(CharacterObject* character, CharacterController* controller) override;
 };
 
@@ -28,6 +28,23 @@ glm::vec3 DefaultAIController::getTargetPosition() {
 
 const float followRadius = 5.f;
 
+bool DefaultAIController::canThinkInParallel() const {
+    // Other goals follow or interact with other characters
+    if (currentGoal != TrafficWander && currentGoal != TrafficDriver) {
+        return false;
+    }
+
+    for (auto activity : {getCurrentActivity(), getNextActivity()}) {
+        if (activity && activity->changesOtherObjects()) {
+            return false;
+        }
+    }
+
+    // Passengers share the vehicle with the driver
+    return character->getCurrentVehicle() == nullptr ||
+           character->getCurrentSeat() == 0;
+}
+
 void DefaultAIController::update(float dt) {
     switch (currentGoal) {
         case FollowLeader: {
@@ -121,12 +138,31 @@ void DefaultAIController::update(float dt) {
                     // Assign the last target node
                     lastTargetNode = targetNode;
 
-                    // Assign the next target node, either it is already set, 
+                    // Stop once we arrived at the destination
+                    if (reachedDestination(lastTargetNode)) {
+                        auto vehicle = getCharacter()->getCurrentVehicle();
+                        vehicle->setThrottle(0.f);
+                        vehicle->setHandbraking(true);
+                        vehicle->clearPathTarget();
+
+                        clearDestination();
+                        targetNode = nullptr;
+                        nextTargetNode = nullptr;
+                        lastTargetNode = nullptr;
+                        currentGoal = None;
+                        break;
+                    }
+
+                    // Assign the next target node, either it is already set,
                     // or we have to find one by ourselves
                     if (nextTargetNode != nullptr) {
                         targetNode = nextTargetNode;
                         nextTargetNode = nullptr;
                     }
+                    else if (auto node =
+                                 nextNodeTowardsDestination(lastTargetNode)) {
+                        targetNode = node;
+                    }
                     else {
                         float mindist = std::numeric_limits<float>::max();
                         for (const auto& node : lastTargetNode->connections) {
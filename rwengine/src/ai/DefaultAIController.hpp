@@ -17,6 +17,8 @@ public:
     glm::vec3 getTargetPosition() override;
 
     void update(float dt) override;
+
+    bool canThinkInParallel() const override;
 };
 
 }  // namespace ai
@@ -0,0 +1,207 @@
+#include "ai/RoutePlanner.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/norm.hpp>
+
+#include "ai/AIGraph.hpp"
+#include "ai/AIGraphNode.hpp"
+
+namespace ai {
+
+namespace {
+constexpr uint32_t kNoParent = std::numeric_limits<uint32_t>::max();
+}  // namespace
+
+RoutePlanner::RoutePlanner(AIGraph& graph) : graph(graph) {
+}
+
+void RoutePlanner::update() {
+    if (builtRevision != graph.revision) {
+        rebuild();
+    }
+}
+
+void RoutePlanner::rebuild() {
+    nodes.clear();
+    nodeIndex.clear();
+    nodes.reserve(graph.nodes.size());
+    for (const auto& node : graph.nodes) {
+        nodeIndex[node.get()] = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(node.get());
+    }
+
+    offsets.clear();
+    edges.clear();
+    costs.clear();
+    offsets.reserve(nodes.size() + 1);
+    for (auto node : nodes) {
+        offsets.push_back(static_cast<uint32_t>(edges.size()));
+        for (auto connection : node->connections) {
+            auto it = nodeIndex.find(connection);
+            if (it == nodeIndex.end()) {
+                continue;
+            }
+            edges.push_back(it->second);
+            costs.push_back(glm::distance(node->position, connection->position));
+        }
+    }
+    offsets.push_back(static_cast<uint32_t>(edges.size()));
+
+    searchNodes.assign(nodes.size(), {0.f, kNoParent, 0, false});
+    searchID = 0;
+    builtRevision = graph.revision;
+
+    cache.clear();
+    cacheIndex.clear();
+}
+
+RoutePlanner::RoutePtr RoutePlanner::findRoute(AIGraphNode* start,
+                                               AIGraphNode* goal) {
+    if (!start || !goal || start->type != goal->type) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    update();
+
+    auto startIt = nodeIndex.find(start);
+    auto goalIt = nodeIndex.find(goal);
+    if (startIt == nodeIndex.end() || goalIt == nodeIndex.end()) {
+        return nullptr;
+    }
+
+    const CacheKey key =
+        (static_cast<CacheKey>(startIt->second) << 32) | goalIt->second;
+    auto cached = cacheIndex.find(key);
+    if (cached != cacheIndex.end()) {
+        // Move to the front, the back is evicted first
+        cache.splice(cache.begin(), cache, cached->second);
+        return cached->second->second;
+    }
+
+    auto route = searchRoute(startIt->second, goalIt->second);
+
+    cache.emplace_front(key, route);
+    cacheIndex[key] = cache.begin();
+    if (cache.size() > kCacheSize) {
+        cacheIndex.erase(cache.back().first);
+        cache.pop_back();
+    }
+
+    return route;
+}
+
+RoutePlanner::RoutePtr RoutePlanner::searchRoute(uint32_t start,
+                                                 uint32_t goal) {
+    // Stale search state is recognised by its id, so it never needs clearing
+    if (++searchID == 0) {
+        for (auto& node : searchNodes) {
+            node.visited = 0;
+        }
+        searchID = 1;
+    }
+
+    const auto& goalPosition = nodes[goal]->position;
+    auto heuristic = [&](uint32_t i) {
+        return glm::distance(nodes[i]->position, goalPosition);
+    };
+
+    using OpenNode = std::pair<float, uint32_t>;
+    std::priority_queue<OpenNode, std::vector<OpenNode>,
+                        std::greater<OpenNode>>
+        open;
+
+    searchNodes[start] = {0.f, kNoParent, searchID, false};
+    open.emplace(heuristic(start), start);
+
+    uint32_t closest = start;
+    float closestDistance = heuristic(start);
+    size_t expanded = 0;
+
+    while (!open.empty() && expanded < kMaxExpansions) {
+        const auto current = open.top().second;
+        open.pop();
+
+        auto& currentNode = searchNodes[current];
+        if (currentNode.closed) {
+            continue;
+        }
+        currentNode.closed = true;
+        expanded++;
+
+        const auto distance = heuristic(current);
+        if (distance < closestDistance) {
+            closest = current;
+            closestDistance = distance;
+        }
+        if (current == goal) {
+            break;
+        }
+
+        for (auto e = offsets[current]; e < offsets[current + 1]; ++e) {
+            const auto next = edges[e];
+            if (nodes[next]->disabled) {
+                continue;
+            }
+
+            const auto cost = currentNode.cost + costs[e];
+            auto& nextNode = searchNodes[next];
+            if (nextNode.visited != searchID) {
+                nextNode = {cost, current, searchID, false};
+            } else if (nextNode.closed || cost >= nextNode.cost) {
+                continue;
+            } else {
+                nextNode.cost = cost;
+                nextNode.parent = current;
+            }
+            open.emplace(cost + heuristic(next), next);
+        }
+    }
+
+    auto route = std::make_shared<Route>();
+    route->complete = closest == goal;
+    for (auto i = closest; i != kNoParent; i = searchNodes[i].parent) {
+        route->nodes.push_back(nodes[i]);
+    }
+    std::reverse(route->nodes.begin(), route->nodes.end());
+    return route;
+}
+
+AIGraphNode* RoutePlanner::findNearestNode(const glm::vec3& position,
+                                           NodeType type) {
+    std::lock_guard<std::mutex> lock(mutex);
+    update();
+
+    AIGraphNode* nearest = nullptr;
+    float nearestDistance = std::numeric_limits<float>::max();
+    for (auto node : nodes) {
+        if (node->type != type || node->disabled) {
+            continue;
+        }
+        const auto d = glm::distance2(node->position, position);
+        if (d < nearestDistance) {
+            nearest = node;
+            nearestDistance = d;
+        }
+    }
+    return nearest;
+}
+
+void RoutePlanner::invalidate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    cache.clear();
+    cacheIndex.clear();
+}
+
+size_t RoutePlanner::getCachedRouteCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cache.size();
+}
+
+}  // namespace ai
@@ -0,0 +1,107 @@
+#ifndef _RWENGINE_ROUTEPLANNER_HPP_
+#define _RWENGINE_ROUTEPLANNER_HPP_
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ai {
+
+class AIGraph;
+enum class NodeType;
+struct AIGraphNode;
+
+/**
+ * @brief Finds routes between nodes of an AIGraph
+ *
+ * The connections of the graph are copied into flat arrays the first time
+ * a route is requested after the graph's revision changed. Routes are found with A*,
+ * using the straight line distance as the heuristic, and never pass through
+ * disabled nodes. Each search expands a limited number of nodes, if the
+ * goal isn't reached by then the route leads to the node found closest to
+ * it. Recent routes are cached.
+ *
+ * Queries may be made from several threads.
+ */
+class RoutePlanner {
+public:
+    struct Route {
+        /// From the start node to the last node, inclusive
+        std::vector<AIGraphNode*> nodes;
+        /// False if the last node isn't the goal
+        bool complete = false;
+    };
+
+    using RoutePtr = std::shared_ptr<const Route>;
+
+    /// Nodes expanded by a single search at most
+    static constexpr size_t kMaxExpansions = 4096;
+
+    /// Number of routes kept in the cache
+    static constexpr size_t kCacheSize = 64;
+
+    explicit RoutePlanner(AIGraph& graph);
+
+    /**
+     * @return the route from start to goal, or nullptr if either node isn't
+     * part of the graph or they have different types
+     */
+    RoutePtr findRoute(AIGraphNode* start, AIGraphNode* goal);
+
+    /**
+     * @return the enabled node of the given type closest to position
+     */
+    AIGraphNode* findNearestNode(const glm::vec3& position, NodeType type);
+
+    /**
+     * Drops the cached routes, called when nodes are enabled or disabled
+     */
+    void invalidate();
+
+    size_t getCachedRouteCount() const;
+
+private:
+    AIGraph& graph;
+    mutable std::mutex mutex;
+
+    /// Compressed adjacency, the edges of node i are [offsets[i], offsets[i+1])
+    std::vector<AIGraphNode*> nodes;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> edges;
+    std::vector<float> costs;
+    std::unordered_map<const AIGraphNode*, uint32_t> nodeIndex;
+    /// Graph revision the arrays were built from
+    uint64_t builtRevision = 0;
+
+    /// Search state, valid for nodes whose visited value is the current search
+    struct SearchNode {
+        float cost;
+        uint32_t parent;
+        uint32_t visited;
+        bool closed;
+    };
+    std::vector<SearchNode> searchNodes;
+    uint32_t searchID = 0;
+
+    using CacheKey = uint64_t;
+    std::list<std::pair<CacheKey, RoutePtr>> cache;
+    std::unordered_map<CacheKey,
+                       std::list<std::pair<CacheKey, RoutePtr>>::iterator>
+        cacheIndex;
+
+    /// Rebuilds the arrays if the graph changed since they were built
+    void update();
+    void rebuild();
+
+    RoutePtr searchRoute(uint32_t start, uint32_t goal);
+};
+
+}  // namespace ai
+
+#endif
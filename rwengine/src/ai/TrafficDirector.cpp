@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
@@ -31,9 +33,9 @@ TrafficDirector::TrafficDirector(AIGraph* g, GameWorld* w)
     , world(w) {
 }
 
-std::vector<ai::AIGraphNode*> TrafficDirector::findAvailableNodes(
+std::pmr::vector<ai::AIGraphNode*> TrafficDirector::findAvailableNodes(
     ai::NodeType type, const ViewCamera& camera, float radius) {
-    std::vector<ai::AIGraphNode*> available;
+    std::pmr::vector<ai::AIGraphNode*> available(&world->getTickArena());
     available.reserve(20);
 
     graph->gatherExternalNodesNear(camera.position, radius, available, type);
@@ -42,10 +44,18 @@ std::vector<ai::AIGraphNode*> TrafficDirector::findAvailableNodes(
     float minDist = (15.f / density) * (15.f / density);
     float halfRadius2 = std::pow(radius / 2.f, 2.f);
 
+    ViewFrustum::SphereBatch nodeSpheres(&world->getTickArena());
+    nodeSpheres.reserve(available.size());
+    for (const auto node : available) {
+        nodeSpheres.add(node->position, 1.f);
+    }
+    camera.frustum.intersects(nodeSpheres);
+
     // Check if any of the nearby nodes are blocked by a pedestrian or vehicle standing on
     // it
     // or because it's inside the view frustum
-    for (auto it = available.begin(); it != available.end();) {
+    size_t nodeIndex = 0;
+    for (auto it = available.begin(); it != available.end(); ++nodeIndex) {
         bool blocked = false;
         float dist2 = glm::distance2(camera.position, (*it)->position);
 
@@ -67,8 +77,7 @@ std::vector<ai::AIGraphNode*> TrafficDirector::findAvailableNodes(
 
         // Check that we're not going to spawn something right where the player
         // is looking
-        if (dist2 <= halfRadius2 &&
-            camera.frustum.intersects((*it)->position, 1.f)) {
+        if (dist2 <= halfRadius2 && nodeSpheres.isVisible(nodeIndex)) {
             blocked = true;
         }
 
@@ -106,6 +115,10 @@ std::vector<GameObject*> TrafficDirector::populateNearby(
 
     // Spawn vehicles at vehicle generators
     auto camera2D = glm::vec2(camera.position);
+    // Generators in range, and whether they are close enough to check the view
+    std::pmr::vector<std::pair<VehicleGenerator*, bool>> generators(
+        &world->getTickArena());
+    ViewFrustum::SphereBatch generatorSpheres(&world->getTickArena());
     for (auto& gen : world->state->vehicleGenerators) {
         /// @todo verify how vehicle generator proximity is determined
         auto gen2D = glm::vec2(gen.position);
@@ -117,22 +130,26 @@ std::vector<GameObject*> TrafficDirector::populateNearby(
                 position = world->getGroundAtPosition(position);
             }
 
-            if (dist2 <= halfRadius2 &&
-                camera.frustum.intersects(position, 1.f)) {
-                if (!gen.alwaysSpawn) {
-                    // Don't spawn in the view frustum unless we're forced to
-                    continue;
-                }
-            }
-            auto spawned = world->tryToSpawnVehicle(gen);
-            if (spawned) {
-                created.push_back(spawned);
-            }
+            generators.emplace_back(&gen, dist2 <= halfRadius2);
+            generatorSpheres.add(position, 1.f);
+        }
+    }
+
+    camera.frustum.intersects(generatorSpheres);
+    for (auto i = 0u; i < generators.size(); ++i) {
+        auto& [gen, nearby] = generators[i];
+        if (nearby && generatorSpheres.isVisible(i) && !gen->alwaysSpawn) {
+            // Don't spawn in the view frustum unless we're forced to
+            continue;
+        }
+        auto spawned = world->tryToSpawnVehicle(*gen);
+        if (spawned) {
+            created.push_back(spawned);
         }
     }
 
     // Hardcoded cop Pedestrian
-    std::vector<uint16_t> peds = {1};
+    std::pmr::vector<uint16_t> peds({1}, &world->getTickArena());
 
     // Determine which zone the viewpoint is in
     auto zone = world->data->findZoneAt(camera.position);
@@ -18,9 +18,13 @@ class TrafficDirector {
 public:
     TrafficDirector(AIGraph* graph, GameWorld* world);
 
-    std::vector<AIGraphNode*> findAvailableNodes(NodeType type,
-                                                 const ViewCamera& camera,
-                                                 float radius);
+    /**
+     * @return the nodes that traffic can spawn at, allocated from the
+     * world's tick arena
+     */
+    std::pmr::vector<AIGraphNode*> findAvailableNodes(NodeType type,
+                                                      const ViewCamera& camera,
+                                                      float radius);
 
     void setDensity(NodeType type, float density);
 
@@ -32,7 +32,7 @@ Sound& SoundManager::getSfxSourceRef(size_t name) {
     return sfx[name];
 }
 
-Sound& SoundManager::getSoundRef(const std::string& name) {
+Sound& SoundManager::getSoundRef(StringId name) {
     return sounds[name];  // @todo reloading, how to check is it wav/mp3?
 }
 
@@ -113,13 +113,14 @@ void SoundManager::deinitializeOpenAL() {
 bool SoundManager::loadSound(const std::string& name,
                              const std::string& fileName, bool streamed) {
     Sound* sound = nullptr;
-    auto sound_iter = sounds.find(name);
+    const auto id = StringId::intern(name);
+    auto sound_iter = sounds.find(id);
 
     if (sound_iter != sounds.end()) {
         sound = &sound_iter->second;
     } else {
         auto [it, emplaced] = sounds.emplace(std::piecewise_construct,
-                                             std::forward_as_tuple(name),
+                                             std::forward_as_tuple(id),
                                              std::forward_as_tuple());
         sound = &it->second;
 
@@ -182,7 +183,7 @@ size_t SoundManager::createSfxInstance(size_t index) {
     return sound->id;
 }
 
-bool SoundManager::isLoaded(const std::string& name) {
+bool SoundManager::isLoaded(StringId name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
         return sound->second.isLoaded;
@@ -190,7 +191,7 @@ bool SoundManager::isLoaded(const std::string& name) {
     return false;
 }
 
-bool SoundManager::isPlaying(const std::string& name) {
+bool SoundManager::isPlaying(StringId name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
         return sound->second.isPlaying();
@@ -198,7 +199,7 @@ bool SoundManager::isPlaying(const std::string& name) {
     return false;
 }
 
-bool SoundManager::isStopped(const std::string& name) {
+bool SoundManager::isStopped(StringId name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
         return sound->second.isStopped();
@@ -206,7 +207,7 @@ bool SoundManager::isStopped(const std::string& name) {
     return false;
 }
 
-bool SoundManager::isPaused(const std::string& name) {
+bool SoundManager::isPaused(StringId name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
         return sound->second.isPaused();
@@ -214,7 +215,7 @@ bool SoundManager::isPaused(const std::string& name) {
     return false;
 }
 
-void SoundManager::playSound(const std::string& name) {
+void SoundManager::playSound(StringId name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
         auto vol = getCalculatedVolumeOfMusic();
@@ -223,7 +224,7 @@ void SoundManager::playSound(const std::string& name) {
     }
 }
 
-void SoundManager::eraseSound(const std::string& name) {
+void SoundManager::eraseSound(StringId name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
         sounds.erase(sound);
@@ -279,7 +280,7 @@ void SoundManager::resumeAllSounds() {
 bool SoundManager::playBackground(const std::string& fileName) {
     if (this->loadSound(fileName, fileName)) {
         backgroundNoise = fileName;
-        auto& sound = getSoundRef(fileName);
+        auto& sound = getSoundRef(StringId(fileName));
         sound.play();
         return true;
     }
@@ -292,14 +293,14 @@ bool SoundManager::loadMusic(const std::string& name,
     return loadSound(name, fileName);
 }
 
-void SoundManager::playMusic(const std::string& name) {
+void SoundManager::playMusic(StringId name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
         sound->second.play();
     }
 }
 
-void SoundManager::stopMusic(const std::string& name) {
+void SoundManager::stopMusic(StringId name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
         sound->second.stop();
@@ -333,11 +334,12 @@ void SoundManager::updateListenerTransform(const ViewCamera& cam) {
     // alListenerfv(AL_VELOCITY, velocity);
 }
 
-void SoundManager::setSoundPosition(const std::string& name,
+void SoundManager::setSoundPosition(StringId name,
                                     const glm::vec3& position) {
-    if (sounds.find(name) != sounds.end()) {
-        alCheck(alSource3f(sounds[name].buffer->source, AL_POSITION, position.x,
-                           position.y, position.z));
+    auto sound = sounds.find(name);
+    if (sound != sounds.end()) {
+        alCheck(alSource3f(sound->second.buffer->source, AL_POSITION,
+                           position.x, position.y, position.z));
     }
 }
 
@@ -8,6 +8,7 @@
 #include <glm/vec3.hpp>
 
 #include <loaders/LoaderSDT.hpp>
+#include <rw/StringId.hpp>
 
 #include <string>
 #include <unordered_map>
@@ -35,27 +36,27 @@ public:
 
     Sound& getSfxBufferRef(size_t name);
     Sound& getSfxSourceRef(size_t name);
-    Sound& getSoundRef(const std::string& name);
+    Sound& getSoundRef(StringId name);
 
     size_t createSfxInstance(size_t index);
 
     /// Checking is selected sound loaded.
-    bool isLoaded(const std::string& name);
+    bool isLoaded(StringId name);
 
     /// Checking is selected sound playing.
-    bool isPlaying(const std::string& name);
+    bool isPlaying(StringId name);
 
     /// Checking is selected sound playing.
-    bool isStopped(const std::string& name);
+    bool isStopped(StringId name);
 
     /// Checking is selected sound playing.
-    bool isPaused(const std::string& name);
+    bool isPaused(StringId name);
 
     /// Play sound with selected name
-    void playSound(const std::string& name);
+    void playSound(StringId name);
 
     /// Erase sound with selected name
-    void eraseSound(const std::string& name);
+    void eraseSound(StringId name);
 
     /// Effect same as playSound with one parametr,
     /// but this function works for sfx and
@@ -72,14 +73,14 @@ public:
     bool playBackground(const std::string& fileName);
 
     bool loadMusic(const std::string& name, const std::string& fileName);
-    void playMusic(const std::string& name);
-    void stopMusic(const std::string& name);
+    void playMusic(StringId name);
+    void stopMusic(StringId name);
 
     /// Updating listener tranform, called by main loop of game.
     void updateListenerTransform(const ViewCamera& cam);
 
     /// Setting position of sound source in buffer.
-    void setSoundPosition(const std::string& name, const glm::vec3& position);
+    void setSoundPosition(StringId name, const glm::vec3& position);
 
     void pause(bool p);
 
@@ -97,7 +98,7 @@ private:
     ALCdevice* alDevice = nullptr;
 
     /// Containers for sounds
-    std::unordered_map<std::string, Sound> sounds;
+    std::unordered_map<StringId, Sound> sounds;
     std::unordered_map<size_t, Sound> sfx;
     std::unordered_map<size_t, Sound> buffers;
 
@@ -0,0 +1,86 @@
+#include "core/FrameArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include <rw/debug.hpp>
+
+namespace {
+constexpr size_t kBlockAlignment = alignof(std::max_align_t);
+
+std::byte* alignUp(std::byte* pointer, size_t alignment) {
+    const auto address = reinterpret_cast<uintptr_t>(pointer);
+    const auto aligned = (address + alignment - 1) & ~(alignment - 1);
+    return pointer + (aligned - address);
+}
+}  // namespace
+
+FrameArena::FrameArena(size_t capacity, std::pmr::memory_resource* upstream)
+    : upstream(upstream), capacity(capacity) {
+    RW_ASSERT(capacity > 0);
+    block = static_cast<std::byte*>(
+        upstream->allocate(capacity, kBlockAlignment));
+    current = block;
+    end = block + capacity;
+}
+
+FrameArena::~FrameArena() {
+    releaseOverflows();
+    upstream->deallocate(block, capacity, kBlockAlignment);
+}
+
+void FrameArena::reset() {
+    highWaterMark = std::max(highWaterMark, used);
+
+    if (overflows) {
+        releaseOverflows();
+
+        // Grow so that a period like the one that overflowed fits in one
+        // block, the padding lost when switching blocks is not counted
+        auto grown = capacity * 2;
+        while (grown < highWaterMark) {
+            grown *= 2;
+        }
+        upstream->deallocate(block, capacity, kBlockAlignment);
+        block = static_cast<std::byte*>(
+            upstream->allocate(grown, kBlockAlignment));
+        capacity = grown;
+    }
+
+    current = block;
+    end = block + capacity;
+    used = 0;
+    lastOverflowCount = overflowCount;
+    overflowCount = 0;
+}
+
+void FrameArena::releaseOverflows() {
+    while (overflows) {
+        auto next = overflows->next;
+        upstream->deallocate(overflows, overflows->size, kBlockAlignment);
+        overflows = next;
+    }
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    auto start = alignUp(current, alignment);
+    if (start > end || static_cast<size_t>(end - start) < bytes) {
+        // Large enough for the request whatever its alignment
+        const auto size =
+            std::max(capacity, sizeof(Overflow) + alignment + bytes);
+        auto overflow = static_cast<Overflow*>(
+            upstream->allocate(size, kBlockAlignment));
+        overflow->next = overflows;
+        overflow->size = size;
+        overflows = overflow;
+        overflowCount++;
+
+        current = reinterpret_cast<std::byte*>(overflow + 1);
+        end = reinterpret_cast<std::byte*>(overflow) + size;
+        start = alignUp(current, alignment);
+    }
+
+    used += static_cast<size_t>(start + bytes - current);
+    current = start + bytes;
+    return start;
+}
@@ -0,0 +1,92 @@
+#ifndef _RWENGINE_FRAMEARENA_HPP_
+#define _RWENGINE_FRAMEARENA_HPP_
+
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @brief Linear allocator for containers that only live for a frame or tick
+ *
+ * Allocations bump a pointer through a single block and deallocation does
+ * nothing, all of the memory is reclaimed at once by reset(). When the
+ * block runs out, further blocks are taken from the upstream resource until
+ * the next reset, which replaces the block with one large enough for the
+ * most that has been used. Once that has settled, allocating from the arena
+ * no longer touches the heap.
+ *
+ * Use it through std::pmr containers, which must not outlive the next
+ * reset. The arena is not thread safe.
+ */
+class FrameArena final : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kDefaultCapacity = 64 * 1024;
+
+    explicit FrameArena(size_t capacity = kDefaultCapacity,
+                        std::pmr::memory_resource* upstream =
+                            std::pmr::new_delete_resource());
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * Releases everything allocated since the last reset, growing the block
+     * if it overflowed
+     */
+    void reset();
+
+    /// Bytes allocated since the last reset
+    size_t getUsed() const {
+        return used;
+    }
+
+    /// Size of the block that is reused every reset
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+    /// Most bytes allocated between two resets
+    size_t getHighWaterMark() const {
+        return highWaterMark;
+    }
+
+    /// Blocks taken from the upstream resource since the last reset
+    size_t getOverflowCount() const {
+        return overflowCount;
+    }
+
+    /// Blocks taken from the upstream resource during the previous period
+    size_t getLastOverflowCount() const {
+        return lastOverflowCount;
+    }
+
+private:
+    /// Header of the blocks taken when the main block is full
+    struct Overflow {
+        Overflow* next;
+        size_t size;
+    };
+
+    std::pmr::memory_resource* upstream;
+    std::byte* block = nullptr;
+    size_t capacity = 0;
+    std::byte* current = nullptr;
+    std::byte* end = nullptr;
+    Overflow* overflows = nullptr;
+    size_t used = 0;
+    size_t highWaterMark = 0;
+    size_t overflowCount = 0;
+    size_t lastOverflowCount = 0;
+
+    void releaseOverflows();
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {
+    }
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+#endif
@@ -0,0 +1,104 @@
+#include "core/FrameStats.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include <rw/debug.hpp>
+
+namespace {
+float elapsedMilliseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+float average(const FrameStats::History& history, size_t count) {
+    if (count == 0) {
+        return 0.f;
+    }
+    // Unused entries are zero, so the whole history can be summed
+    return std::accumulate(history.begin(), history.end(), 0.f) /
+           static_cast<float>(count);
+}
+}  // namespace
+
+FrameStats::ScopedTimer::ScopedTimer(FrameStats* stats, Stage stage)
+    : stats(stats), stage(stage) {
+    if (stats) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+FrameStats::ScopedTimer::~ScopedTimer() {
+    if (stats) {
+        stats->addTime(stage, elapsedMilliseconds(start));
+    }
+}
+
+const char* FrameStats::getStageName(Stage stage) {
+    switch (stage) {
+        case Stage::Input:
+            return "Input";
+        case Stage::Tick:
+            return "Tick";
+        case Stage::Physics:
+            return "Physics step";
+        case Stage::Objects:
+            return "Objects";
+        case Stage::Script:
+            return "Script";
+        case Stage::Render:
+            return "Render";
+        case Stage::RenderList:
+            return "Render list";
+        case Stage::Sort:
+            return "Sort";
+        case Stage::Draw:
+            return "Draw";
+        case Stage::Swap:
+            return "Swap";
+        default:
+            RW_UNIMPLEMENTED("Unknown frame stage");
+            return "";
+    }
+}
+
+int FrameStats::getStageDepth(Stage stage) {
+    switch (stage) {
+        case Stage::Physics:
+        case Stage::Objects:
+        case Stage::Script:
+        case Stage::RenderList:
+        case Stage::Draw:
+            return 1;
+        case Stage::Sort:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+void FrameStats::addTime(Stage stage, float milliseconds) {
+    current[static_cast<size_t>(stage)] += milliseconds;
+}
+
+void FrameStats::endFrame() {
+    frameTimes[next] = elapsedMilliseconds(lastFrameEnd);
+    lastFrameEnd = std::chrono::steady_clock::now();
+
+    for (auto i = 0u; i < kStageCount; ++i) {
+        stageTimes[i][next] = current[i];
+    }
+    current.fill(0.f);
+
+    next = (next + 1) % kHistorySize;
+    frames = std::min(frames + 1, kHistorySize);
+}
+
+float FrameStats::getAverage(Stage stage) const {
+    return average(getStageTimes(stage), frames);
+}
+
+float FrameStats::getAverageFrameTime() const {
+    return average(frameTimes, frames);
+}
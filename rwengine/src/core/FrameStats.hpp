@@ -0,0 +1,100 @@
+#ifndef _RWENGINE_FRAMESTATS_HPP_
+#define _RWENGINE_FRAMESTATS_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief Time spent in each stage of the game loop over recent frames
+ *
+ * A lightweight alternative to the microprofile integration that is always
+ * built in, so timings can be shown in release builds. Times are in
+ * milliseconds and summed when a stage runs several times in a frame.
+ */
+class FrameStats {
+public:
+    /// Stages are nested in the ones before them with a lower depth
+    enum class Stage {
+        Input,
+        Tick,
+        Physics,
+        Objects,
+        Script,
+        Render,
+        RenderList,
+        Sort,
+        Draw,
+        Swap,
+        Count
+    };
+
+    static constexpr size_t kStageCount = static_cast<size_t>(Stage::Count);
+
+    /// Number of frames kept
+    static constexpr size_t kHistorySize = 240;
+
+    using History = std::array<float, kHistorySize>;
+
+    /**
+     * Adds the time until destruction to a stage, nothing if stats is null
+     */
+    class ScopedTimer {
+    public:
+        ScopedTimer(FrameStats* stats, Stage stage);
+        ~ScopedTimer();
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        FrameStats* stats;
+        Stage stage;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    static const char* getStageName(Stage stage);
+
+    static int getStageDepth(Stage stage);
+
+    void addTime(Stage stage, float milliseconds);
+
+    /**
+     * Stores the times of the current frame in the history and starts the
+     * next one
+     */
+    void endFrame();
+
+    /**
+     * Frame durations, the oldest is at getHistoryOffset()
+     */
+    const History& getFrameTimes() const {
+        return frameTimes;
+    }
+
+    const History& getStageTimes(Stage stage) const {
+        return stageTimes[static_cast<size_t>(stage)];
+    }
+
+    size_t getHistoryOffset() const {
+        return next;
+    }
+
+    /**
+     * @return the average time of a stage over the history
+     */
+    float getAverage(Stage stage) const;
+
+    float getAverageFrameTime() const;
+
+private:
+    std::array<float, kStageCount> current{};
+    std::array<History, kStageCount> stageTimes{};
+    History frameTimes{};
+    size_t next = 0;
+    size_t frames = 0;
+    std::chrono::steady_clock::time_point lastFrameEnd =
+        std::chrono::steady_clock::now();
+};
+
+#endif
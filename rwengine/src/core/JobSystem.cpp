@@ -0,0 +1,195 @@
+#include "core/JobSystem.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include <rw/debug.hpp>
+
+#include "core/Profiler.hpp"
+
+namespace {
+/// The JobSystem owning the current thread, if it is a worker
+thread_local const JobSystem* currentSystem = nullptr;
+thread_local size_t currentQueue = 0;
+}  // namespace
+
+JobSystem::JobSystem(unsigned int workerCount) {
+    queues.reserve(workerCount + 1);
+    for (auto i = 0u; i < workerCount + 1; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+
+    workers.reserve(workerCount);
+    for (auto i = 0u; i < workerCount; ++i) {
+        workers.emplace_back(&JobSystem::workerMain, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t JobSystem::getQueueIndex() const {
+    return currentSystem == this ? currentQueue : workers.size();
+}
+
+void JobSystem::run(Job job, Counter& counter) {
+    if (workers.empty()) {
+        job();
+        return;
+    }
+
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        auto& queue = *queues[getQueueIndex()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back({std::move(job), &counter});
+    }
+    queued.fetch_add(1);
+
+    // Sleeping workers check queued while holding sleepMutex
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wake.notify_one();
+}
+
+void JobSystem::wait(Counter& counter) {
+    const auto queueIndex = getQueueIndex();
+    while (!counter.done()) {
+        if (!runQueuedJob(queueIndex)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::runQueuedJob(size_t queueIndex) {
+    QueuedJob item;
+    bool found = false;
+
+    // Newest job from our own queue first, it is most likely to be cached
+    {
+        auto& queue = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            item = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            found = true;
+        }
+    }
+
+    // Otherwise steal the oldest job from another queue
+    for (auto i = 1u; !found && i < queues.size(); ++i) {
+        auto& queue = *queues[(queueIndex + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            item = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    queued.fetch_sub(1);
+    item.job();
+    item.counter->pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void JobSystem::workerMain(size_t queueIndex) {
+    currentSystem = this;
+    currentQueue = queueIndex;
+    RW_PROFILE_THREAD(("Worker " + std::to_string(queueIndex)).c_str());
+
+    while (true) {
+        if (runQueuedJob(queueIndex)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize,
+                            const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    grainSize = std::max(grainSize, size_t{1});
+    Counter counter;
+    for (auto begin = grainSize; begin < count; begin += grainSize) {
+        const auto end = std::min(begin + grainSize, count);
+        run([&body, begin, end] { body(begin, end); }, counter);
+    }
+
+    body(0, std::min(grainSize, count));
+    wait(counter);
+}
+
+void JobSystem::run(TaskGraph& graph) {
+    const auto count = graph.tasks.size();
+    if (count == 0) {
+        return;
+    }
+
+    auto remaining = std::make_unique<std::atomic<size_t>[]>(count);
+    for (auto i = 0u; i < count; ++i) {
+        remaining[i].store(graph.tasks[i].dependencies,
+                           std::memory_order_relaxed);
+    }
+
+    std::atomic<size_t> finished{0};
+    Counter counter;
+    std::function<void(TaskGraph::TaskID)> schedule =
+        [&](TaskGraph::TaskID id) {
+            run(
+                [&, id] {
+                    const auto& task = graph.tasks[id];
+                    task.function();
+                    finished.fetch_add(1, std::memory_order_relaxed);
+                    // Successors are queued before this job is counted as
+                    // finished, so the counter can't reach zero early
+                    for (auto successor : task.successors) {
+                        if (remaining[successor].fetch_sub(
+                                1, std::memory_order_acq_rel) == 1) {
+                            schedule(successor);
+                        }
+                    }
+                },
+                counter);
+        };
+
+    for (auto i = 0u; i < count; ++i) {
+        if (graph.tasks[i].dependencies == 0) {
+            schedule(i);
+        }
+    }
+
+    wait(counter);
+    RW_CHECK(finished.load() == count, "TaskGraph contains a cycle");
+}
+
+TaskGraph::TaskID TaskGraph::add(std::function<void()> task) {
+    tasks.push_back({std::move(task), {}, 0});
+    return tasks.size() - 1;
+}
+
+void TaskGraph::precede(TaskID before, TaskID after) {
+    RW_ASSERT(before < tasks.size() && after < tasks.size());
+    tasks[before].successors.push_back(after);
+    tasks[after].dependencies++;
+}
@@ -0,0 +1,142 @@
+#ifndef _RWENGINE_JOBSYSTEM_HPP_
+#define _RWENGINE_JOBSYSTEM_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskGraph;
+
+/**
+ * @brief Pool of worker threads running short jobs for the game loop
+ *
+ * Every worker owns a queue of jobs. Jobs queued by a worker are pushed to
+ * the back of its own queue and run from there, idle workers steal from the
+ * front of the other queues. Threads waiting for jobs run queued jobs in the
+ * meantime, so jobs may queue and wait for jobs of their own.
+ *
+ * A JobSystem without workers runs every job on the calling thread.
+ */
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    /**
+     * Number of unfinished jobs in a group, see run() and wait()
+     */
+    class Counter {
+    public:
+        bool done() const {
+            return pending.load(std::memory_order_acquire) == 0;
+        }
+
+    private:
+        friend class JobSystem;
+        std::atomic<size_t> pending{0};
+    };
+
+    explicit JobSystem(unsigned int workerCount);
+
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned int getWorkerCount() const {
+        return static_cast<unsigned int>(workers.size());
+    }
+
+    /**
+     * Queues the job, counter is decremented once the job has finished
+     */
+    void run(Job job, Counter& counter);
+
+    /**
+     * Runs queued jobs until every job tracked by counter has finished
+     */
+    void wait(Counter& counter);
+
+    /**
+     * Calls body(begin, end) for consecutive ranges of at most grainSize
+     * indices covering [0, count), returns when every range has finished.
+     * The calling thread runs the first range.
+     */
+    void parallelFor(size_t count, size_t grainSize,
+                     const std::function<void(size_t, size_t)>& body);
+
+    /**
+     * Runs every task in the graph, no task starts before the tasks it
+     * depends on have finished. Returns when every task has finished.
+     */
+    void run(TaskGraph& graph);
+
+private:
+    struct QueuedJob {
+        Job job;
+        Counter* counter;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<QueuedJob> jobs;
+    };
+
+    /// One queue per worker, followed by one for threads outside the pool
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued{0};
+    bool stopping = false;
+
+    size_t getQueueIndex() const;
+
+    bool runQueuedJob(size_t queueIndex);
+
+    void workerMain(size_t queueIndex);
+};
+
+/**
+ * @brief Set of tasks with dependencies between them, run by a JobSystem
+ *
+ * The graph may be run any number of times, it must not contain cycles.
+ */
+class TaskGraph {
+public:
+    using TaskID = size_t;
+
+    TaskID add(std::function<void()> task);
+
+    /**
+     * after is not started until before has finished
+     */
+    void precede(TaskID before, TaskID after);
+
+    size_t size() const {
+        return tasks.size();
+    }
+
+    void clear() {
+        tasks.clear();
+    }
+
+private:
+    friend class JobSystem;
+
+    struct Task {
+        std::function<void()> function;
+        std::vector<TaskID> successors;
+        size_t dependencies = 0;
+    };
+
+    std::vector<Task> tasks;
+};
+
+#endif
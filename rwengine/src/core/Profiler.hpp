@@ -11,6 +11,21 @@
 #define RW_PROFILE_COUNTER_SET(name, qty) MICROPROFILE_COUNTER_SET(name, qty)
 #define RW_TIMELINE_ENTER(name, color) MICROPROFILE_TIMELINE_ENTER_STATIC(color, name)
 #define RW_TIMELINE_LEAVE(name) MICROPROFILE_TIMELINE_LEAVE_STATIC(name)
+#define RW_PROFILE_WRITE_TRACE(path) (static_cast<void>(path), false)
+#elif defined(RW_TRACE_PROFILER)
+#include <core/TraceProfiler.hpp>
+#define RW_PROFILE_CONCAT_(a, b) a##b
+#define RW_PROFILE_CONCAT(a, b) RW_PROFILE_CONCAT_(a, b)
+#define RW_PROFILE_THREAD(name) TraceProfiler::setThreadName(name)
+#define RW_PROFILE_FRAME_BOUNDARY() TraceProfiler::frameBoundary()
+#define RW_PROFILE_SCOPE(label) \
+    TraceProfiler::Scope RW_PROFILE_CONCAT(rwProfileScope, __COUNTER__)(label)
+#define RW_PROFILE_SCOPEC(label, colour) RW_PROFILE_SCOPE(label)
+#define RW_PROFILE_COUNTER_ADD(name, qty) TraceProfiler::addCounter(name, qty)
+#define RW_PROFILE_COUNTER_SET(name, qty) TraceProfiler::setCounter(name, qty)
+#define RW_TIMELINE_ENTER(name, color) TraceProfiler::timelineEnter(name)
+#define RW_TIMELINE_LEAVE(name) TraceProfiler::timelineLeave(name)
+#define RW_PROFILE_WRITE_TRACE(path) TraceProfiler::write(path)
 #else
 #define RW_PROFILE_THREAD(name) do {} while (0)
 #define RW_PROFILE_FRAME_BOUNDARY() do {} while (0)
@@ -20,6 +35,7 @@
 #define RW_PROFILE_COUNTER_SET(name, qty) do {} while (0)
 #define RW_TIMELINE_ENTER(name, color) do {} while (0)
 #define RW_TIMELINE_LEAVE(name) do {} while (0)
+#define RW_PROFILE_WRITE_TRACE(path) (static_cast<void>(path), false)
 #endif
 
 #endif
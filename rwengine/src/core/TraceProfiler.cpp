@@ -0,0 +1,202 @@
+#include "core/TraceProfiler.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+struct Event {
+    const char* name;
+    /// Nanoseconds since the profiler started
+    uint64_t time;
+    int64_t value;
+    char phase;
+};
+
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<Event> events;
+    std::string name;
+    uint32_t id;
+    size_t dropped = 0;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::unordered_map<std::string, int64_t> counters;
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+};
+
+Registry& getRegistry() {
+    // Never destroyed, threads may still record during static destruction
+    static auto registry = new Registry;
+    return *registry;
+}
+
+ThreadBuffer& getThreadBuffer() {
+    thread_local ThreadBuffer* buffer = [] {
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto created = std::make_unique<ThreadBuffer>();
+        created->id = static_cast<uint32_t>(registry.buffers.size());
+        created->name = "Thread " + std::to_string(created->id);
+        created->events.reserve(1u << 16);
+        registry.buffers.push_back(std::move(created));
+        return registry.buffers.back().get();
+    }();
+    return *buffer;
+}
+
+void record(const char* name, char phase, int64_t value = 0) {
+    const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() -
+                          getRegistry().start)
+                          .count();
+    auto& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.events.size() >= TraceProfiler::kMaxEventsPerThread) {
+        buffer.dropped++;
+        return;
+    }
+    buffer.events.push_back(
+        {name, static_cast<uint64_t>(time), value, phase});
+}
+
+void updateCounter(const char* name, int64_t value, bool add) {
+    auto& registry = getRegistry();
+    int64_t total;
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto& counter = registry.counters[name];
+        counter = add ? counter + value : value;
+        total = counter;
+    }
+    record(name, 'C', total);
+}
+
+void writeString(std::ostream& out, const char* string) {
+    out << '"';
+    for (auto c = string; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            out << ' ';
+        } else {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+}  // namespace
+
+void TraceProfiler::setThreadName(const char* name) {
+    auto& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.name = name;
+}
+
+void TraceProfiler::beginScope(const char* name) {
+    record(name, 'B');
+}
+
+void TraceProfiler::endScope() {
+    record(nullptr, 'E');
+}
+
+void TraceProfiler::setCounter(const char* name, int64_t value) {
+    updateCounter(name, value, false);
+}
+
+void TraceProfiler::addCounter(const char* name, int64_t value) {
+    updateCounter(name, value, true);
+}
+
+void TraceProfiler::timelineEnter(const char* name) {
+    record(name, 'b');
+}
+
+void TraceProfiler::timelineLeave(const char* name) {
+    record(name, 'e');
+}
+
+void TraceProfiler::frameBoundary() {
+    record("Frame", 'i');
+}
+
+bool TraceProfiler::write(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"traceEvents\":[\n";
+
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> registryLock(registry.mutex);
+    bool first = true;
+    for (auto& buffer : registry.buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+
+        if (!first) {
+            out << ",\n";
+        }
+        first = false;
+        out << R"({"name":"thread_name","ph":"M","pid":1,"tid":)"
+            << buffer->id << R"(,"args":{"name":)";
+        writeString(out, buffer->name.c_str());
+        out << "}}";
+
+        for (const auto& event : buffer->events) {
+            out << ",\n{\"ph\":\"" << event.phase << "\",\"ts\":"
+                << static_cast<double>(event.time) / 1000.0
+                << ",\"pid\":1,\"tid\":" << buffer->id;
+            if (event.name) {
+                out << ",\"name\":";
+                writeString(out, event.name);
+            }
+            switch (event.phase) {
+                case 'C':
+                    out << ",\"args\":{\"value\":" << event.value << '}';
+                    break;
+                case 'b':
+                case 'e':
+                    out << ",\"cat\":\"timeline\",\"id\":";
+                    writeString(out, event.name);
+                    break;
+                case 'i':
+                    out << ",\"s\":\"g\"";
+                    break;
+                default:
+                    break;
+            }
+            out << '}';
+        }
+
+        if (buffer->dropped > 0) {
+            out << ",\n{\"ph\":\"M\",\"name\":\"dropped_events\",\"pid\":1,"
+                << "\"tid\":" << buffer->id << ",\"args\":{\"count\":"
+                << buffer->dropped << "}}";
+        }
+    }
+    out << "\n]}\n";
+
+    return static_cast<bool>(out);
+}
+
+void TraceProfiler::clear() {
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> registryLock(registry.mutex);
+    registry.counters.clear();
+    for (auto& buffer : registry.buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        buffer->events.clear();
+        buffer->dropped = 0;
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef _RWENGINE_TRACEPROFILER_HPP_
+#define _RWENGINE_TRACEPROFILER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Records profile scopes into a Chrome trace event file
+ *
+ * Backend of the RW_PROFILE macros when built with RW_TRACE_PROFILER.
+ * Each thread appends events to a buffer of its own, the buffers are merged
+ * when the trace is written. The resulting JSON can be opened in
+ * chrome://tracing or Perfetto, or compared between runs.
+ *
+ * Scope, counter and timeline names must outlive the trace, string
+ * literals and __func__ do.
+ */
+class TraceProfiler {
+public:
+    /// Events kept per thread, later events are dropped
+    static constexpr size_t kMaxEventsPerThread = 1u << 21;
+
+    class Scope {
+    public:
+        explicit Scope(const char* name) {
+            beginScope(name);
+        }
+        ~Scope() {
+            endScope();
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    static void setThreadName(const char* name);
+
+    static void beginScope(const char* name);
+    static void endScope();
+
+    static void setCounter(const char* name, int64_t value);
+    static void addCounter(const char* name, int64_t value);
+
+    /**
+     * Marks a span that may begin and end in different scopes
+     */
+    static void timelineEnter(const char* name);
+    static void timelineLeave(const char* name);
+
+    static void frameBoundary();
+
+    /**
+     * Writes every event recorded so far
+     * @return false if the file couldn't be written
+     */
+    static bool write(const std::string& path);
+
+    /**
+     * Drops every event recorded so far
+     */
+    static void clear();
+};
+
+#endif
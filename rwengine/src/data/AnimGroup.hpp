@@ -9,6 +9,7 @@
 #include <string>
 #include <unordered_map>
 
+#include <rw/StringId.hpp>
 #include <rw/forward.hpp>
 
 /**
@@ -240,6 +241,6 @@ struct AnimGroup {
     }
 };
 
-using AnimGroups = std::unordered_map<std::string, std::unique_ptr<AnimGroup>>;
+using AnimGroups = std::unordered_map<NameId, std::unique_ptr<AnimGroup>>;
 
 #endif
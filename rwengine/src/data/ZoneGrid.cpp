@@ -0,0 +1,87 @@
+#include "data/ZoneGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "data/ZoneData.hpp"
+
+namespace {
+void gatherZones(ZoneData& zone, std::vector<ZoneData*>& ordered) {
+    for (ZoneData* child : zone.children_) {
+        gatherZones(*child, ordered);
+    }
+    ordered.push_back(&zone);
+}
+
+int32_t clampCell(float offset, int32_t count) {
+    // Clamped before converting, far away points don't fit an int
+    const auto cell = std::floor(offset / ZoneGrid::kCellSize);
+    return static_cast<int32_t>(
+        std::clamp(cell, 0.f, static_cast<float>(count - 1)));
+}
+}  // namespace
+
+int32_t ZoneGrid::cellX(float x) const {
+    return clampCell(x - origin.x, width);
+}
+
+int32_t ZoneGrid::cellY(float y) const {
+    return clampCell(y - origin.y, height);
+}
+
+void ZoneGrid::build(ZoneData& root) {
+    std::vector<ZoneData*> ordered;
+    gatherZones(root, ordered);
+
+    origin = glm::vec2(root.min.x, root.min.y);
+    width = std::max(
+        static_cast<int32_t>(std::ceil((root.max.x - root.min.x) / kCellSize)),
+        1);
+    height = std::max(
+        static_cast<int32_t>(std::ceil((root.max.y - root.min.y) / kCellSize)),
+        1);
+
+    // Count the zones of each cell, then fill them in order
+    cellStart.assign(static_cast<size_t>(width * height) + 1, 0);
+    for (auto zone : ordered) {
+        for (auto x = cellX(zone->min.x); x <= cellX(zone->max.x); ++x) {
+            for (auto y = cellY(zone->min.y); y <= cellY(zone->max.y); ++y) {
+                cellStart[x * height + y + 1]++;
+            }
+        }
+    }
+    for (auto i = 1u; i < cellStart.size(); ++i) {
+        cellStart[i] += cellStart[i - 1];
+    }
+
+    zones.resize(cellStart.back());
+    auto next = cellStart;
+    for (auto zone : ordered) {
+        for (auto x = cellX(zone->min.x); x <= cellX(zone->max.x); ++x) {
+            for (auto y = cellY(zone->min.y); y <= cellY(zone->max.y); ++y) {
+                zones[next[x * height + y]++] = zone;
+            }
+        }
+    }
+}
+
+void ZoneGrid::clear() {
+    width = height = 0;
+    cellStart.clear();
+    zones.clear();
+}
+
+ZoneData* ZoneGrid::findZoneAt(const glm::vec3& point) const {
+    if (zones.empty()) {
+        return nullptr;
+    }
+
+    // Points outside the grid are outside the root zone as well
+    const auto cell = cellX(point.x) * height + cellY(point.y);
+    for (auto i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+        if (zones[i]->containsPoint(point)) {
+            return zones[i];
+        }
+    }
+    return nullptr;
+}
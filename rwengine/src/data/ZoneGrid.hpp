@@ -0,0 +1,56 @@
+#ifndef _RWENGINE_ZONEGRID_HPP_
+#define _RWENGINE_ZONEGRID_HPP_
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+struct ZoneData;
+
+/**
+ * @brief Flattened lookup of the zone hierarchy
+ *
+ * Splits the root zone into a grid of cells, each listing the zones that
+ * overlap it in the order ZoneData::findLeafAtPoint visits them, children
+ * before their parents. The first zone in the cell containing a point is
+ * the same zone the tree walk would return.
+ *
+ * Must be rebuilt whenever the hierarchy changes.
+ */
+class ZoneGrid {
+public:
+    static constexpr float kCellSize = 100.f;
+
+    /**
+     * Builds the grid for root and every zone below it
+     */
+    void build(ZoneData& root);
+
+    void clear();
+
+    bool empty() const {
+        return zones.empty();
+    }
+
+    /**
+     * @return the deepest zone containing point, or nullptr if it is outside
+     * of the root zone
+     */
+    ZoneData* findZoneAt(const glm::vec3& point) const;
+
+private:
+    glm::vec2 origin{};
+    int32_t width = 0;
+    int32_t height = 0;
+
+    /// The zones of cell i are zones[cellStart[i], cellStart[i+1])
+    std::vector<uint32_t> cellStart;
+    std::vector<ZoneData*> zones;
+
+    int32_t cellX(float x) const;
+    int32_t cellY(float y) const;
+};
+
+#endif
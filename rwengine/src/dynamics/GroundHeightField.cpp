@@ -0,0 +1,136 @@
+#include "dynamics/GroundHeightField.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4305)
+#endif
+#include <btBulletDynamicsCommon.h>
+#ifdef _MSC_VER
+#pragma warning(default : 4305)
+#endif
+
+#include <glm/glm.hpp>
+
+namespace {
+constexpr float kSampleSpacing = 4.f;
+constexpr int32_t kCellSamples = 16;
+constexpr int32_t kCellStride = kCellSamples + 1;
+/// Largest height difference between neighbouring samples to interpolate
+constexpr float kMaxHeightStep = 1.f;
+constexpr float kRayTop = 100.f;
+constexpr float kRayBottom = -100.f;
+constexpr float kUnsampled = std::numeric_limits<float>::infinity();
+
+uint64_t cellKey(int32_t x, int32_t y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+           static_cast<uint32_t>(y);
+}
+
+int32_t floorDiv(int32_t a, int32_t b) {
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+}
+}  // namespace
+
+GroundHeightField::GroundHeightField(btCollisionWorld& world) : world(world) {
+}
+
+void GroundHeightField::invalidate(const glm::vec2& min,
+                                   const glm::vec2& max) {
+    const auto sxMin = static_cast<int32_t>(std::ceil(min.x / kSampleSpacing));
+    const auto syMin = static_cast<int32_t>(std::ceil(min.y / kSampleSpacing));
+    const auto sxMax = static_cast<int32_t>(std::floor(max.x / kSampleSpacing));
+    const auto syMax = static_cast<int32_t>(std::floor(max.y / kSampleSpacing));
+
+    // Samples on a cell edge are stored by both cells
+    for (auto cy = floorDiv(syMin - 1, kCellSamples);
+         cy <= floorDiv(syMax, kCellSamples); ++cy) {
+        for (auto cx = floorDiv(sxMin - 1, kCellSamples);
+             cx <= floorDiv(sxMax, kCellSamples); ++cx) {
+            auto it = cells.find(cellKey(cx, cy));
+            if (it == cells.end()) {
+                continue;
+            }
+            auto& heights = it->second.heights;
+            const auto iMin = std::max(sxMin - cx * kCellSamples, 0);
+            const auto iMax = std::min(sxMax - cx * kCellSamples, kCellSamples);
+            const auto jMin = std::max(syMin - cy * kCellSamples, 0);
+            const auto jMax = std::min(syMax - cy * kCellSamples, kCellSamples);
+            for (auto j = jMin; j <= jMax; ++j) {
+                for (auto i = iMin; i <= iMax; ++i) {
+                    heights[static_cast<size_t>(j * kCellStride + i)] =
+                        kUnsampled;
+                }
+            }
+        }
+    }
+}
+
+void GroundHeightField::clear() {
+    cells.clear();
+}
+
+float GroundHeightField::sampleHeight(float x, float y) {
+    btVector3 rayFrom(x, y, kRayTop);
+    btVector3 rayTo(x, y, kRayBottom);
+
+    btCollisionWorld::ClosestRayResultCallback rr(rayFrom, rayTo);
+    rr.m_collisionFilterMask = btBroadphaseProxy::StaticFilter;
+
+    world.rayTest(rayFrom, rayTo, rr);
+    sampleCount++;
+
+    if (!rr.hasHit()) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    return rr.m_hitPointWorld.z();
+}
+
+GroundHeightField::Cell& GroundHeightField::getCell(int32_t x, int32_t y) {
+    auto [it, inserted] = cells.try_emplace(cellKey(x, y));
+    if (inserted) {
+        it->second.heights.assign(kCellStride * kCellStride, kUnsampled);
+    }
+    return it->second;
+}
+
+std::optional<float> GroundHeightField::getHeight(const glm::vec2& position) {
+    const auto grid = position / kSampleSpacing;
+    const auto sx = static_cast<int32_t>(std::floor(grid.x));
+    const auto sy = static_cast<int32_t>(std::floor(grid.y));
+    const auto cx = floorDiv(sx, kCellSamples);
+    const auto cy = floorDiv(sy, kCellSamples);
+    auto& cell = getCell(cx, cy);
+
+    // Samples are shared along cell edges, so all four are in this cell
+    const auto i = sx - cx * kCellSamples;
+    const auto j = sy - cy * kCellSamples;
+    const auto at = [&](int32_t u, int32_t v) {
+        auto& height = cell.heights[static_cast<size_t>(v * kCellStride + u)];
+        if (height == kUnsampled) {
+            height = sampleHeight(
+                static_cast<float>(cx * kCellSamples + u) * kSampleSpacing,
+                static_cast<float>(cy * kCellSamples + v) * kSampleSpacing);
+        }
+        return height;
+    };
+    const float h00 = at(i, j);
+    const float h10 = at(i + 1, j);
+    const float h01 = at(i, j + 1);
+    const float h11 = at(i + 1, j + 1);
+
+    if (std::isnan(h00) || std::isnan(h10) || std::isnan(h01) ||
+        std::isnan(h11)) {
+        return std::nullopt;
+    }
+    const auto [low, high] = std::minmax({h00, h10, h01, h11});
+    if (high - low > kMaxHeightStep) {
+        return std::nullopt;
+    }
+
+    const float tx = grid.x - static_cast<float>(sx);
+    const float ty = grid.y - static_cast<float>(sy);
+    return glm::mix(glm::mix(h00, h10, tx), glm::mix(h01, h11, tx), ty);
+}
@@ -0,0 +1,73 @@
+#ifndef _RWENGINE_GROUNDHEIGHTFIELD_HPP_
+#define _RWENGINE_GROUNDHEIGHTFIELD_HPP_
+
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+class btCollisionWorld;
+
+/**
+ * @brief Cache of the height of the static world on a regular grid
+ *
+ * Heights are sampled with downward rays against static collision objects
+ * the first time a sample is needed, and looked up with bilinear filtering
+ * afterwards. Where the samples around a point disagree (kerbs, bridges,
+ * building edges) or are missing, no height is returned and the caller
+ * should cast a ray itself.
+ *
+ * Only static objects are sampled, anything that moves has to be tested
+ * for separately.
+ */
+class GroundHeightField {
+public:
+    explicit GroundHeightField(btCollisionWorld& world);
+
+    /**
+     * @return the interpolated ground height, or nothing if the cached
+     * samples can't be trusted at this position
+     */
+    std::optional<float> getHeight(const glm::vec2& position);
+
+    /**
+     * Drops the samples within an area, called when static objects in it
+     * are created or destroyed
+     */
+    void invalidate(const glm::vec2& min, const glm::vec2& max);
+
+    /**
+     * Drops every cached sample
+     */
+    void clear();
+
+    size_t getCellCount() const {
+        return cells.size();
+    }
+
+    /// Number of rays cast so far
+    size_t getSampleCount() const {
+        return sampleCount;
+    }
+
+private:
+    struct Cell {
+        /**
+         * (kCellSamples + 1)^2 heights, NaN where nothing was hit and
+         * infinity where the sample hasn't been taken yet
+         */
+        std::vector<float> heights;
+    };
+
+    btCollisionWorld& world;
+    std::unordered_map<uint64_t, Cell> cells;
+    size_t sampleCount = 0;
+
+    Cell& getCell(int32_t x, int32_t y);
+
+    float sampleHeight(float x, float y);
+};
+
+#endif
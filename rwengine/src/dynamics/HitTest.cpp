@@ -5,7 +5,6 @@
 #pragma warning(disable : 4305 5033)
 #endif
 #include <btBulletDynamicsCommon.h>
-#include <BulletCollision/CollisionDispatch/btGhostObject.h>
 
 #ifdef _MSC_VER
 #pragma warning(default : 4305 5033)
@@ -13,52 +12,92 @@
 
 namespace {
 
-HitTest::TestResult HitTestWorld(btDiscreteDynamicsWorld& world, btPairCachingGhostObject& tester)
-{
-    world.addCollisionObject(&tester);
+/**
+ * Collects the objects that a default collision object overlapping the
+ * AABB would have been paired with.
+ */
+class HitCollector final : public btBroadphaseAabbCallback {
+public:
+    explicit HitCollector(HitTest::TestResult& hits)
+        : _hits(hits) {
+    }
 
-    HitTest::TestResult result;
-    result.reserve(static_cast<unsigned long>(tester.getNumOverlappingObjects()));
+    bool process(const btBroadphaseProxy* proxy) override {
+        if (!(proxy->m_collisionFilterMask & btBroadphaseProxy::DefaultFilter)) {
+            return true;
+        }
 
-    for (auto i = 0; i < tester.getNumOverlappingObjects(); ++i)
-    {
-        auto overlapping = tester.getOverlappingObject(i);
+        auto body = static_cast<btCollisionObject*>(proxy->m_clientObject);
+        _hits.push_back({body, static_cast<GameObject*>(body->getUserPointer())});
+        return true;
+    }
 
-        HitTest::Hit hit{};
-        hit.body = overlapping;
+private:
+    HitTest::TestResult& _hits;
+};
 
-        if (auto object = static_cast<GameObject*>(overlapping->getUserPointer()))
-        {
-            hit.object = object;
-        }
+glm::vec3 boxExtents(const glm::vec3& size, const glm::quat& rotation) {
+    const auto basis = glm::mat3_cast(rotation);
+    return glm::abs(basis[0]) * size.x + glm::abs(basis[1]) * size.y +
+           glm::abs(basis[2]) * size.z;
+}
 
-        result.push_back(hit);
-    }
+} // namespace
+
+void HitTest::aabbTest(const glm::vec3& center, const glm::vec3& extents,
+                       TestResult& hits) {
+    // Collision objects in the world have their AABB expanded the same way
+    const auto margin = extents + glm::vec3(gContactBreakingThreshold);
+    const auto min = center - margin;
+    const auto max = center + margin;
+
+    HitCollector collector{hits};
+    _world.getBroadphase()->aabbTest({min.x, min.y, min.z},
+                                     {max.x, max.y, max.z}, collector);
+}
 
-    world.removeCollisionObject(&tester);
+HitTest::TestResult HitTest::sphereTest(const glm::vec3& center, float radius) {
+    TestResult result;
+    sphereTest(center, radius, result);
+    return result;
+}
 
+HitTest::TestResult HitTest::boxTest(const glm::vec3 &center, const glm::vec3 &size, const glm::quat& rotation) {
+    TestResult result;
+    boxTest(center, size, rotation, result);
     return result;
 }
 
-HitTest::TestResult HitTestWithShape(btDiscreteDynamicsWorld& world, btCollisionShape& shape,
-        const glm::vec3& center, const glm::quat& rotation) {
-    btPairCachingGhostObject ghost{};
-    btTransform xform{};
-    xform.setOrigin({center.x, center.y, center.z});
-    xform.setRotation({rotation.x, rotation.y, rotation.z, rotation.w});
-    ghost.setWorldTransform(xform);
-    ghost.setCollisionShape(&shape);
-    return HitTestWorld(world, ghost);
+void HitTest::sphereTest(const glm::vec3& center, float radius,
+                         TestResult& result) {
+    result.clear();
+    aabbTest(center, glm::vec3(radius), result);
 }
 
-} // namespace
+void HitTest::boxTest(const glm::vec3& center, const glm::vec3& size,
+                      const glm::quat& rotation, TestResult& result) {
+    result.clear();
+    aabbTest(center, boxExtents(size, rotation), result);
+}
 
-HitTest::TestResult HitTest::sphereTest(const glm::vec3& center, float radius) {
-    btSphereShape sphere {radius};
-    return HitTestWithShape(_world, sphere, center, {});
+void HitTest::sphereTests(const Sphere* spheres, size_t count,
+                          BatchResult& result) {
+    result.clear();
+    result.offsets.reserve(count + 1);
+    result.offsets.push_back(0);
+    for (auto i = 0u; i < count; ++i) {
+        aabbTest(spheres[i].center, glm::vec3(spheres[i].radius), result.hits);
+        result.offsets.push_back(result.hits.size());
+    }
 }
 
-HitTest::TestResult HitTest::boxTest(const glm::vec3 &center, const glm::vec3 &size, const glm::quat& rotation) {
-    btBoxShape box {{size.x, size.y, size.z}};
-    return HitTestWithShape(_world, box, center, rotation);
+void HitTest::boxTests(const Box* boxes, size_t count, BatchResult& result) {
+    result.clear();
+    result.offsets.reserve(count + 1);
+    result.offsets.push_back(0);
+    for (auto i = 0u; i < count; ++i) {
+        aabbTest(boxes[i].center, boxExtents(boxes[i].size, boxes[i].rotation),
+                 result.hits);
+        result.offsets.push_back(result.hits.size());
+    }
 }
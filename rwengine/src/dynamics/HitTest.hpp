@@ -4,6 +4,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#include <cstddef>
 #include <vector>
 #include <memory>
 
@@ -13,6 +14,10 @@ class GameObject;
 
 /**
  * Utility for performing collision tests against the world.
+ *
+ * Tests query the broadphase directly, so nothing is added to or removed
+ * from the world and no shapes are created. Results can be written into
+ * buffers owned by the caller to avoid allocating for every test.
  */
 class HitTest {
 public:
@@ -20,7 +25,44 @@ public:
         btCollisionObject* body;
         GameObject* object;
     };
-    using TestResult = std::vector<Hit>;
+    using TestResult = std::pmr::vector<Hit>;
+
+    struct Sphere {
+        glm::vec3 center;
+        float radius;
+    };
+
+    struct Box {
+        glm::vec3 center;
+        glm::vec3 size;
+        glm::quat rotation{1.f, 0.f, 0.f, 0.f};
+    };
+
+    /**
+     * Results of several tests, the hits for test i are in the range
+     * [offsets[i], offsets[i + 1]) of hits.
+     */
+    struct BatchResult {
+        TestResult hits;
+        std::vector<size_t> offsets;
+
+        void clear() {
+            hits.clear();
+            offsets.clear();
+        }
+
+        size_t size() const {
+            return offsets.empty() ? 0 : offsets.size() - 1;
+        }
+
+        const Hit* begin(size_t test) const {
+            return hits.data() + offsets[test];
+        }
+
+        const Hit* end(size_t test) const {
+            return hits.data() + offsets[test + 1];
+        }
+    };
 
     explicit HitTest(btDiscreteDynamicsWorld& world)
         : _world(world)
@@ -31,8 +73,24 @@ public:
     TestResult sphereTest(const glm::vec3& center, float radius);
     TestResult boxTest(const glm::vec3& center, const glm::vec3& size, const glm::quat& rotation = {1.f, 0.f, 0.f, 0.f});
 
+    /**
+     * Clears result and fills it with the hits of the test
+     */
+    void sphereTest(const glm::vec3& center, float radius, TestResult& result);
+    void boxTest(const glm::vec3& center, const glm::vec3& size,
+                 const glm::quat& rotation, TestResult& result);
+
+    /**
+     * Runs count tests, replacing the contents of result
+     */
+    void sphereTests(const Sphere* spheres, size_t count, BatchResult& result);
+    void boxTests(const Box* boxes, size_t count, BatchResult& result);
+
 private:
     btDiscreteDynamicsWorld& _world;
+
+    void aabbTest(const glm::vec3& center, const glm::vec3& extents,
+                  TestResult& hits);
 };
 
 
@@ -0,0 +1,19 @@
+#ifndef _RWENGINE_PHYSICSLOD_HPP_
+#define _RWENGINE_PHYSICSLOD_HPP_
+
+#include <cstdint>
+
+/**
+ * How much physics simulation an object receives, chosen by its distance
+ * from the player.
+ */
+enum class PhysicsLOD : uint8_t {
+    /// Fully simulated by the dynamics world
+    Full,
+    /// Collides with other bodies, but is moved by the object itself
+    Kinematic,
+    /// Not part of the dynamics world at all
+    Disabled
+};
+
+#endif
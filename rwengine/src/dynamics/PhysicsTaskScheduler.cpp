@@ -0,0 +1,142 @@
+#include "dynamics/PhysicsTaskScheduler.hpp"
+
+#ifdef RW_PHYSICS_MT
+
+#include <algorithm>
+
+PhysicsTaskScheduler::PhysicsTaskScheduler(int numThreads)
+    : btITaskScheduler("OpenRW") {
+    setNumThreads(numThreads);
+}
+
+PhysicsTaskScheduler::~PhysicsTaskScheduler() {
+    stopWorkers();
+}
+
+int PhysicsTaskScheduler::getMaxNumThreads() const {
+    return BT_MAX_THREAD_COUNT;
+}
+
+int PhysicsTaskScheduler::getNumThreads() const {
+    return static_cast<int>(workers.size()) + 1;
+}
+
+void PhysicsTaskScheduler::setNumThreads(int numThreads) {
+    numThreads = std::clamp(numThreads, 1, getMaxNumThreads());
+    if (numThreads == getNumThreads()) {
+        return;
+    }
+    stopWorkers();
+    startWorkers(numThreads - 1);
+}
+
+void PhysicsTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize,
+                                       const btIParallelForBody& body) {
+    const RangeFunction function = [&body](int begin, int end) {
+        body.forLoop(begin, end);
+    };
+    run(iBegin, iEnd, grainSize, function);
+}
+
+btScalar PhysicsTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize,
+                                           const btIParallelSumBody& body) {
+    std::mutex sumMutex;
+    btScalar sum = 0;
+    const RangeFunction function = [&](int begin, int end) {
+        const auto partial = body.sumLoop(begin, end);
+        std::lock_guard<std::mutex> lock(sumMutex);
+        sum += partial;
+    };
+    run(iBegin, iEnd, grainSize, function);
+    return sum;
+}
+
+void PhysicsTaskScheduler::run(int iBegin, int iEnd, int grainSize,
+                               const RangeFunction& body) {
+    const auto grain = std::max(grainSize, 1);
+    if (workers.empty() || iEnd - iBegin <= grain) {
+        body(iBegin, iEnd);
+        return;
+    }
+
+    // The workers only take one task at a time, nested calls run inline
+    if (running.exchange(true, std::memory_order_acquire)) {
+        body(iBegin, iEnd);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &body;
+        taskEnd = iEnd;
+        taskGrain = grain;
+        nextIndex = iBegin;
+        activeWorkers = workers.size();
+        ++generation;
+    }
+    wake.notify_all();
+
+    // The calling thread works on the range too
+    runChunks();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return activeWorkers == 0; });
+    task = nullptr;
+    running.store(false, std::memory_order_release);
+}
+
+void PhysicsTaskScheduler::runChunks() {
+    for (;;) {
+        const auto begin = nextIndex.fetch_add(taskGrain);
+        if (begin >= taskEnd) {
+            return;
+        }
+        (*task)(begin, std::min(begin + taskGrain, taskEnd));
+    }
+}
+
+void PhysicsTaskScheduler::workerMain(uint64_t lastGeneration) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] {
+                return stopping || generation != lastGeneration;
+            });
+            if (stopping) {
+                return;
+            }
+            lastGeneration = generation;
+        }
+
+        runChunks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--activeWorkers == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void PhysicsTaskScheduler::startWorkers(int count) {
+    stopping = false;
+    workers.reserve(static_cast<size_t>(count));
+    for (auto i = 0; i < count; ++i) {
+        // Workers may start after the first task has been posted
+        workers.emplace_back(&PhysicsTaskScheduler::workerMain, this,
+                             generation);
+    }
+}
+
+void PhysicsTaskScheduler::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef _RWENGINE_PHYSICSTASKSCHEDULER_HPP_
+#define _RWENGINE_PHYSICSTASKSCHEDULER_HPP_
+
+#ifdef RW_PHYSICS_MT
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4305)
+#endif
+#include <LinearMath/btThreads.h>
+#ifdef _MSC_VER
+#pragma warning(default : 4305)
+#endif
+
+#if BT_BULLET_VERSION < 288
+#error "ENABLE_PHYSICS_MT requires Bullet 2.88 or newer"
+#endif
+
+/**
+ * @brief Bullet task scheduler running on a fixed set of worker threads
+ *
+ * Ranges are split into chunks of the requested grain size, which the
+ * workers and the calling thread take from a shared counter until the
+ * range is exhausted. Calls do not return until every chunk is done.
+ *
+ * Only one range is shared with the workers at a time, a call made while
+ * another is in flight (from inside a chunk, or from another thread) runs
+ * its range on the calling thread.
+ */
+class PhysicsTaskScheduler final : public btITaskScheduler {
+public:
+    /**
+     * @param numThreads total number of threads, including the thread
+     * stepping the world
+     */
+    explicit PhysicsTaskScheduler(int numThreads = 1);
+
+    ~PhysicsTaskScheduler() override;
+
+    int getMaxNumThreads() const override;
+
+    int getNumThreads() const override;
+
+    void setNumThreads(int numThreads) override;
+
+    void parallelFor(int iBegin, int iEnd, int grainSize,
+                     const btIParallelForBody& body) override;
+
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize,
+                         const btIParallelSumBody& body) override;
+
+private:
+    using RangeFunction = std::function<void(int, int)>;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    const RangeFunction* task = nullptr;
+    int taskEnd = 0;
+    int taskGrain = 1;
+    std::atomic<int> nextIndex{0};
+    std::atomic<bool> running{false};
+    size_t activeWorkers = 0;
+    uint64_t generation = 0;
+    bool stopping = false;
+
+    void run(int iBegin, int iEnd, int grainSize, const RangeFunction& body);
+
+    void runChunks();
+
+    void workerMain(uint64_t lastGeneration);
+
+    void startWorkers(int count);
+
+    void stopWorkers();
+};
+
+#endif
+
+#endif
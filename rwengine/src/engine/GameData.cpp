@@ -33,12 +33,22 @@
 #include "loaders/LoaderGXT.hpp"
 #include "platform/FileIndex.hpp"
 
+namespace {
+// Size of each page of the shared model geometry buffer
+constexpr size_t kGeometryPageVertices = 1 << 18;
+constexpr size_t kGeometryPageIndices = 1 << 20;
+}  // namespace
+
 GameData::GameData(Logger* log, const std::filesystem::path& path)
     : datpath(path), logger(log) {
     dffLoader.setTextureLookupCallback(
         [&](const std::string& texture, const std::string&) {
-            return findSlotTexture(currenttextureslot, texture);
+            return findSlotTexture(currenttextureslot, NameId(texture));
         });
+    dffLoader.setVertexFormat(LoaderDFF::VertexFormat::Packed);
+    dffLoader.setGeometryBuffer(
+        SharedGeometryBuffer::create<PackedGeometryVertex>(
+            kGeometryPageVertices, kGeometryPageIndices));
 }
 
 bool GameData::load() {
@@ -52,12 +62,11 @@ bool GameData::load() {
     /// @todo cuts.img files should be loaded differently to gta3.img
     loadIMG("anim/cuts.img");
 
-    textureSlots["particle"] = loadTextureArchive("particle.txd");
-    textureSlots["icons"] = loadTextureArchive("icons.txd");
-    textureSlots["hud"] = loadTextureArchive("hud.txd");
-    textureSlots["fonts"] = loadTextureArchive("fonts.txd");
-    textureSlots["generic"] = loadTextureArchive("generic.txd");
-    loadToTextureArchive("misc.txd", textureSlots["generic"]);
+    for (const std::string slot : {"particle", "icons", "hud", "fonts",
+                                   "generic"}) {
+        textureSlots[NameId::intern(slot)] = loadTextureArchive(slot + ".txd");
+    }
+    loadToTextureArchive("misc.txd", textureSlots["generic"_nid]);
 
     loadCarcols("data/carcols.dat");
     loadWeather("data/timecyc.dat");
@@ -70,12 +79,13 @@ bool GameData::load() {
     loadIFP("ped.ifp");
 
     /// @todo load real data
-    pedAnimGroups["player"] = std::make_unique<AnimGroup>(
+    pedAnimGroups[NameId::intern("player")] = std::make_unique<AnimGroup>(
         AnimGroup::getBuiltInAnimGroup(animations, "player"));
 
     // Clear existing zones
     gamezones = ZoneDataList{
         {"CITYZON", 0, {-4000.f, -4000.f, -500.f}, {4000.f, 4000.f, 500.f}, 0, 0, 0}};
+    zoneGrid.clear();
 
     loadLevelFile("data/default.dat");
     loadLevelFile("data/gta3.dat");
@@ -96,7 +106,7 @@ void GameData::loadLevelFile(const std::string& path) {
     }
 
     // Reset texture slot
-    currenttextureslot = "generic";
+    currenttextureslot = "generic"_nid;
 
     for (std::string line, cmd; std::getline(datfile, line);) {
         if (line.empty() || line[0] == '#') continue;
@@ -163,14 +173,16 @@ uint16_t GameData::findModelObject(const std::string model) {
 }
 
 AnimGroup* GameData::getAnimGroup(const std::string& group) {
-    auto it = pedAnimGroups.find(group);
+    const auto id = NameId::intern(group);
+    auto it = pedAnimGroups.find(id);
     if (it != pedAnimGroups.end()) {
         return it->second.get();
     }
 
-    pedAnimGroups[group] = std::make_unique<AnimGroup>(
+    auto& animGroup = pedAnimGroups[id];
+    animGroup = std::make_unique<AnimGroup>(
         AnimGroup::getBuiltInAnimGroup(animations, group));
-    return pedAnimGroups[group].get();
+    return animGroup.get();
 }
 
 void GameData::loadCOL(const size_t zone, const std::string& name) {
@@ -223,6 +235,7 @@ bool GameData::loadZone(const std::string& path) {
         }
         gamezones[0].insertZone(zone);
     }
+    zoneGrid.build(gamezones[0]);
 
     return true;
 }
@@ -364,15 +377,15 @@ void GameData::loadTXD(const std::string& name) {
     }
 
     // Set the current texture slot
-    currenttextureslot = slot;
+    currenttextureslot = NameId::intern(slot);
 
     // Check if this texture slot is loaded already
-    auto slotit = textureSlots.find(slot);
+    auto slotit = textureSlots.find(currenttextureslot);
     if (slotit != textureSlots.end()) {
         return;
     }
 
-    textureSlots[slot] = loadTextureArchive(name);
+    textureSlots[currenttextureslot] = loadTextureArchive(name);
 }
 
 TextureArchive GameData::loadTextureArchive(const std::string& name) {
@@ -433,9 +446,9 @@ ClumpPtr GameData::loadClump(const std::string& name) {
 }
 
 ClumpPtr GameData::loadClump(const std::string& name, const std::string& textureSlot) {
-    std::string currentSlot = currenttextureslot;
+    auto currentSlot = currenttextureslot;
     if (!textureSlot.empty())
-        currenttextureslot = textureSlot;
+        currenttextureslot = NameId(textureSlot);
     ClumpPtr result = loadClump(name);
     currenttextureslot = currentSlot;
     return result;
@@ -680,7 +693,7 @@ bool GameData::loadAudioStream(const std::string& name) {
     auto systempath = index.findFilePath("audio/" + name).string();
 
     if (engine->cutsceneAudio.length() > 0) {
-        engine->sound.stopMusic(engine->cutsceneAudio);
+        engine->sound.stopMusic(StringId(engine->cutsceneAudio));
     }
 
     if (engine->sound.loadMusic(name, systempath)) {
@@ -716,12 +729,13 @@ void GameData::loadSplash(const std::string& name) {
     std::string lower(name);
     std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
 
-    textureSlots[lower + ".txd"] = loadTextureArchive(lower + ".txd");
+    textureSlots[NameId::intern(lower + ".txd")] =
+        loadTextureArchive(lower + ".txd");
 
     engine->state->currentSplash = lower;
 }
 
-TextureData* GameData::findSlotTexture(const std::string &slot, const std::string &texture) const {
+TextureData* GameData::findSlotTexture(NameId slot, NameId texture) const {
     auto slotIt = textureSlots.find(slot);
     if (slotIt == textureSlots.end()) {
         return nullptr;
@@ -733,6 +747,24 @@ TextureData* GameData::findSlotTexture(const std::string &slot, const std::strin
     return textureIt->second.get();
 }
 
+size_t GameData::getTextureMemory() const {
+    // Textures are uploaded as RGBA8 with a mipmap chain
+    size_t bytes = 0;
+    for (const auto& slot : textureSlots) {
+        for (const auto& texture : slot.second) {
+            const auto& size = texture.second->getSize();
+            bytes += static_cast<size_t>(size.x) * static_cast<size_t>(size.y) *
+                     4 * 4 / 3;
+        }
+    }
+    return bytes;
+}
+
+size_t GameData::getGeometryMemory() const {
+    const auto& buffer = dffLoader.getGeometryBuffer();
+    return buffer ? buffer->getBufferSize() : 0;
+}
+
 ZoneData *GameData::findZone(const std::string &name) {
     auto it =
             std::find_if(gamezones.begin(), gamezones.end(),
@@ -742,6 +774,9 @@ ZoneData *GameData::findZone(const std::string &name) {
 
 ZoneData *GameData::findZoneAt(const glm::vec3 &pos) {
     RW_CHECK(!gamezones.empty(), "No game zones loaded");
+    if (!zoneGrid.empty()) {
+        return zoneGrid.findZoneAt(pos);
+    }
     ZoneData* zone = gamezones[0].findLeafAtPoint(pos);
     return zone;
 }
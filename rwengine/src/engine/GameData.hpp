@@ -14,6 +14,7 @@
 #include <platform/FileIndex.hpp>
 #include <rw/debug.hpp>
 #include <rw/forward.hpp>
+#include <rw/StringId.hpp>
 
 #include <data/AnimGroup.hpp>
 #include <data/ModelData.hpp>
@@ -21,6 +22,7 @@
 #include <data/WeaponData.hpp>
 #include <data/Weather.hpp>
 #include <data/ZoneData.hpp>
+#include <data/ZoneGrid.hpp>
 #include <fonts/GameTexts.hpp>
 #include <loaders/LoaderDFF.hpp>
 #include <loaders/LoaderIMG.hpp>
@@ -45,7 +47,7 @@ class GameData {
 private:
     std::filesystem::path datpath;
     std::string splash;
-    std::string currenttextureslot;
+    NameId currenttextureslot;
 
     Logger* logger;
     LoaderDFF dffLoader;
@@ -195,8 +197,17 @@ public:
 
     void loadSplash(const std::string& name);
 
-    TextureData* findSlotTexture(const std::string& slot,
-                                        const std::string& texture) const;
+    TextureData* findSlotTexture(NameId slot, NameId texture) const;
+
+    /**
+     * @return estimated bytes of video memory used by loaded textures
+     */
+    size_t getTextureMemory() const;
+
+    /**
+     * @return bytes of video memory reserved for model geometry
+     */
+    size_t getGeometryMemory() const;
 
     FileIndex index;
 
@@ -217,6 +228,11 @@ public:
 
     ZoneDataList gamezones;
 
+    /**
+     * Lookup of the gamezones hierarchy, rebuilt when zones are loaded
+     */
+    ZoneGrid zoneGrid;
+
     ZoneDataList mapzones;
 
     ZoneData* findZone(const std::string& name);
@@ -265,7 +281,7 @@ public:
     /**
      * Texture slots, containing loaded textures.
      */
-    std::unordered_map<std::string, TextureArchive> textureSlots;
+    std::unordered_map<NameId, TextureArchive> textureSlots;
 
     /**
      * Texture atlases.
@@ -297,7 +313,7 @@ public:
     /**
      * DynamicObjectData
      */
-    std::unordered_map<std::string, DynamicObjectData> dynamicObjectData;
+    std::unordered_map<NameId, DynamicObjectData> dynamicObjectData;
 
     std::vector<WeaponData> weaponData;
 
@@ -5,6 +5,11 @@
 #endif
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 #include <btBulletDynamicsCommon.h>
+#ifdef RW_PHYSICS_MT
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#endif
 #ifdef _MSC_VER
 #pragma warning(default : 4305)
 #endif
@@ -13,19 +18,24 @@
 
 #include <data/Clump.hpp>
 
+#include "core/JobSystem.hpp"
 #include "core/Profiler.hpp"
 #include "core/Logger.hpp"
 
 #include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
 #include "engine/Payphone.hpp"
+#include "engine/TickCommands.hpp"
 
 #include "ai/AIGraphNode.hpp"
 #include "ai/DefaultAIController.hpp"
 #include "ai/PlayerController.hpp"
 #include "ai/TrafficDirector.hpp"
 
+#include "dynamics/CollisionInstance.hpp"
+#include "dynamics/GroundHeightField.hpp"
 #include "dynamics/HitTest.hpp"
+#include "dynamics/PhysicsTaskScheduler.hpp"
 
 #include "data/CutsceneData.hpp"
 #include "data/InstanceData.hpp"
@@ -53,16 +63,31 @@
 // Behaviour Tuning
 constexpr float kMaxTrafficSpawnRadius = 100.f;
 constexpr float kMaxTrafficCleanupRadius = kMaxTrafficSpawnRadius * 1.25f;
+constexpr float kPhysicsFullRadius = 50.f;
+constexpr float kPhysicsKinematicRadius = 90.f;
+constexpr float kPhysicsLODHysteresis = 10.f;
+
+// Objects per job in tickObjects, each job records into its own TickCommands
+constexpr size_t kObjectGrainSize = 8;
 
 namespace {
-template <typename T>
-bool shouldEffectBeRemoved(const T& effect, float gameTime) {
-    if (effect->getType() != Particle) {
-        return false;
+PhysicsLOD selectPhysicsLOD(PhysicsLOD current, float distance) {
+    // Objects have to move a little past a boundary to change back, so they
+    // don't switch every tick while sitting on it
+    const float fullRadius = current == PhysicsLOD::Full
+                                 ? kPhysicsFullRadius + kPhysicsLODHysteresis
+                                 : kPhysicsFullRadius;
+    const float kinematicRadius =
+        current == PhysicsLOD::Disabled
+            ? kPhysicsKinematicRadius - kPhysicsLODHysteresis
+            : kPhysicsKinematicRadius;
+    if (distance < fullRadius) {
+        return PhysicsLOD::Full;
     }
-    auto particle = static_cast<ParticleFX*>(effect.get());
-    return particle->lifetime >= 0.f &&
-           gameTime >= particle->starttime + particle->lifetime;
+    if (distance < kinematicRadius) {
+        return PhysicsLOD::Kinematic;
+    }
+    return PhysicsLOD::Disabled;
 }
 }  // namespace
 
@@ -78,18 +103,42 @@ public:
     }
 };
 
-GameWorld::GameWorld(Logger* log, GameData* dat)
+GameWorld::GameWorld(Logger* log, GameData* dat, int physicsThreads)
     : logger(log), data(dat), sound(this) {
     data->engine = this;
 
     collisionConfig = std::make_unique<btDefaultCollisionConfiguration>();
-    collisionDispatcher =
-        std::make_unique<WorldCollisionDispatcher>(collisionConfig.get());
     broadphase = std::make_unique<btDbvtBroadphase>();
-    solver = std::make_unique<btSequentialImpulseConstraintSolver>();
-    dynamicsWorld = std::make_unique<btDiscreteDynamicsWorld>(
-        collisionDispatcher.get(), broadphase.get(), solver.get(),
-        collisionConfig.get());
+#ifdef RW_PHYSICS_MT
+    if (physicsThreads > 1) {
+        taskScheduler = std::make_unique<PhysicsTaskScheduler>(physicsThreads);
+        btSetTaskScheduler(taskScheduler.get());
+
+        collisionDispatcher = std::make_unique<btCollisionDispatcherMt>(
+            collisionConfig.get());
+        solverPool = std::make_unique<btConstraintSolverPoolMt>(
+            taskScheduler->getNumThreads());
+        solver = std::make_unique<btSequentialImpulseConstraintSolverMt>();
+        dynamicsWorld = std::make_unique<btDiscreteDynamicsWorldMt>(
+            collisionDispatcher.get(), broadphase.get(), solverPool.get(),
+            solver.get(), collisionConfig.get());
+    } else
+#endif
+    {
+        if (physicsThreads > 1) {
+            logger->warning("World",
+                            "Built without ENABLE_PHYSICS_MT, physics will "
+                            "run on a single thread");
+        }
+        collisionDispatcher =
+            std::make_unique<WorldCollisionDispatcher>(collisionConfig.get());
+        solver = std::make_unique<btSequentialImpulseConstraintSolver>();
+        dynamicsWorld = std::make_unique<btDiscreteDynamicsWorld>(
+            collisionDispatcher.get(), broadphase.get(), solver.get(),
+            collisionConfig.get());
+    }
+
+    groundHeights = std::make_unique<GroundHeightField>(*dynamicsWorld);
 
     dynamicsWorld->setGravity(btVector3(0.f, 0.f, -9.81f));
     _overlappingPairCallback = std::make_unique<btGhostPairCallback>();
@@ -103,11 +152,19 @@ GameWorld::GameWorld(Logger* log, GameData* dat)
 GameWorld::~GameWorld() {
     // Bullet requires to remove each object before all physic world
     pedestrianPool.clear();
+    instanceTree.clear();
     instancePool.clear();
     vehiclePool.clear();
     pickupPool.clear();
     cutscenePool.clear();
     projectilePool.clear();
+
+#ifdef RW_PHYSICS_MT
+    // Bullet keeps using the installed scheduler after the world is gone
+    if (taskScheduler && btGetTaskScheduler() == taskScheduler.get()) {
+        btSetTaskScheduler(btGetSequentialTaskScheduler());
+    }
+#endif
 }
 
 bool GameWorld::placeItems(const std::string& name) {
@@ -122,6 +179,7 @@ bool GameWorld::placeItems(const std::string& name) {
                                            name);
             }
         }
+        instanceTree.rebuild();
 
         return true;
     } else {
@@ -144,7 +202,7 @@ InstanceObject* GameWorld::createInstance(const uint16_t id,
         }
 
         // Check for dynamic data.
-        const auto dyIt = data->dynamicObjectData.find(oi->name);
+        const auto dyIt = data->dynamicObjectData.find(NameId(oi->name));
 
         DynamicObjectData* dydata = nullptr;
 
@@ -164,6 +222,8 @@ InstanceObject* GameWorld::createInstance(const uint16_t id,
 
         instancePool.insert(std::move(instance));
         allObjects.push_back(ptr);
+        instanceTree.insert(ptr);
+        invalidateGroundHeights(ptr);
 
         modelInstances.emplace(oi->name, ptr);
 
@@ -208,6 +268,88 @@ void GameWorld::cleanupTraffic(const ViewCamera& focus) {
     destroyQueuedObjects();
 }
 
+void GameWorld::updatePhysicsLOD(const glm::vec3& focus) {
+    RW_PROFILE_SCOPE(__func__);
+    for (auto& p : vehiclePool.objects) {
+        auto vehicle = static_cast<VehicleObject*>(p.second.get());
+        auto lod = PhysicsLOD::Full;
+        if (vehicle->getLifetime() == GameObject::TrafficLifetime) {
+            lod = selectPhysicsLOD(
+                vehicle->getPhysicsLOD(),
+                glm::distance(focus, vehicle->getPosition()));
+        }
+        vehicle->setPhysicsLOD(lod);
+    }
+    for (auto& p : pedestrianPool.objects) {
+        auto character = static_cast<CharacterObject*>(p.second.get());
+        auto lod = PhysicsLOD::Full;
+        if (character->getLifetime() == GameObject::TrafficLifetime) {
+            lod = selectPhysicsLOD(
+                character->getPhysicsLOD(),
+                glm::distance(focus, character->getPosition()));
+        }
+        character->setPhysicsLOD(lod);
+    }
+}
+
+void GameWorld::tickObjects(float dt) {
+    RW_PROFILE_SCOPE(__func__);
+    // Objects created while ticking wait for the next tick
+    if (!jobSystem || jobSystem->getWorkerCount() == 0) {
+        const auto count = allObjects.size();
+        for (auto i = 0u; i < count; ++i) {
+            allObjects[i]->tick(dt);
+        }
+        return;
+    }
+
+    parallelObjects.clear();
+    serialObjects.clear();
+    for (auto object : allObjects) {
+        if (object->canTickInParallel()) {
+            parallelObjects.push_back(object);
+        } else {
+            serialObjects.push_back(object);
+        }
+    }
+
+    const auto rangeCount =
+        (parallelObjects.size() + kObjectGrainSize - 1) / kObjectGrainSize;
+    if (tickCommands.size() < rangeCount) {
+        tickCommands.resize(rangeCount);
+    }
+    // Seeded in order, so the numbers drawn don't depend on the scheduling
+    for (auto i = 0u; i < rangeCount; ++i) {
+        tickCommands[i].random.seed(randomNumberGen());
+    }
+
+    jobSystem->parallelFor(
+        parallelObjects.size(), kObjectGrainSize,
+        [&](size_t begin, size_t end) {
+            RW_PROFILE_SCOPE("think");
+            TickCommands::Scope scope(tickCommands[begin / kObjectGrainSize]);
+            for (auto i = begin; i < end; ++i) {
+                parallelObjects[i]->tick(dt);
+            }
+        });
+
+    {
+        RW_PROFILE_SCOPE("apply");
+        for (auto i = 0u; i < rangeCount; ++i) {
+            tickCommands[i].apply(*this);
+        }
+    }
+
+    for (auto object : serialObjects) {
+        object->tick(dt);
+    }
+}
+
+std::default_random_engine& GameWorld::getRandomEngine() {
+    auto commands = TickCommands::current();
+    return commands ? commands->random : randomNumberGen;
+}
+
 CutsceneObject* GameWorld::createCutsceneObject(const uint16_t id,
                                                 const glm::vec3& pos,
                                                 const glm::quat& rot) {
@@ -290,8 +432,8 @@ VehicleObject* GameWorld::createVehicle(const uint16_t id, const glm::vec3& pos,
 
             if (name == "chassis_dummy") {
                 // These are nested within chassis_dummy
-                auto frontseat = frame->findDescendant("ped_frontseat");
-                auto backseat = frame->findDescendant("ped_backseat");
+                auto frontseat = frame->findDescendant("ped_frontseat"_nid);
+                auto backseat = frame->findDescendant("ped_backseat"_nid);
 
                 if (frontseat) {
                     addSeats(info->second.seats.front,
@@ -510,6 +652,12 @@ GameObject* GameWorld::getBlipTarget(const BlipData& blip) const {
 }
 
 void GameWorld::destroyObject(GameObject* object) {
+    if (object->type() == GameObject::Instance) {
+        auto instance = static_cast<InstanceObject*>(object);
+        instanceTree.remove(instance);
+        invalidateGroundHeights(instance);
+    }
+
     auto& pool = getTypeObjectPool(object);
     pool.remove(object);
 
@@ -528,6 +676,10 @@ void GameWorld::destroyObject(GameObject* object) {
 
 void GameWorld::destroyObjectQueued(GameObject* object) {
     RW_CHECK(object != nullptr, "destroying a null object?");
+    if (auto commands = TickCommands::current()) {
+        commands->destroy(object);
+        return;
+    }
     if (object) deletionQueue.insert(object);
 }
 
@@ -545,11 +697,13 @@ LightFX& GameWorld::createLightEffect() {
     return ref;
 }
 
-ParticleFX& GameWorld::createParticleEffect() {
-    auto effect = std::make_unique<ParticleFX>();
-    auto& ref = *effect;
-    effects.push_back(std::move(effect));
-    return ref;
+ParticleSystem::Handle GameWorld::createParticleEffect(
+    const ParticleFX& particle) {
+    return particles.spawn(particle);
+}
+
+void GameWorld::destroyParticleEffect(ParticleSystem::Handle particle) {
+    particles.destroy(particle);
 }
 
 TrailFX& GameWorld::createTrailEffect() {
@@ -570,11 +724,16 @@ void GameWorld::destroyEffect(VisualFX& effect) {
 }
 
 void GameWorld::doWeaponScan(const WeaponScan& scan) {
+    if (auto commands = TickCommands::current()) {
+        commands->damage(scan);
+        return;
+    }
+
     if (scan.type == ScanType::Radius) {
         HitTest test {*dynamicsWorld};
-        const auto& result = test.sphereTest(scan.center, scan.radius);
+        test.sphereTest(scan.center, scan.radius, weaponScanHits);
 
-        for(const auto& target : result) {
+        for(const auto& target : weaponScanHits) {
             if (!scan.doesDamage(target.object)) {
                 continue;
             }
@@ -636,7 +795,25 @@ void GameWorld::offsetGameTime(int minutes) {
     state->basic.gameHour = gameHour;
 }
 
+void GameWorld::invalidateGroundHeights(InstanceObject* instance) {
+    if (!instance->body) {
+        return;
+    }
+
+    btVector3 min, max;
+    instance->body->getBulletBody()->getAabb(min, max);
+
+    std::lock_guard<std::mutex> lock(physicsQueryMutex);
+    groundHeights->invalidate({min.x(), min.y()}, {max.x(), max.y()});
+}
+
 glm::vec3 GameWorld::getGroundAtPosition(const glm::vec3& pos) const {
+    // Reached from objects thinking in parallel
+    std::lock_guard<std::mutex> lock(physicsQueryMutex);
+    if (auto height = groundHeights->getHeight(glm::vec2(pos))) {
+        return {pos.x, pos.y, *height};
+    }
+
     btVector3 rayFrom(pos.x, pos.y, 100.f);
     btVector3 rayTo(pos.x, pos.y, -100.f);
 
@@ -671,13 +848,11 @@ void handleVehicleResponse(GameObject* object, btManifoldPoint& mp, bool isA) {
         dmg = mp.getPositionWorldOnB();
     }
 
-    object->takeDamage({
-                           GameObject::DamageInfo::DamageType::Physics,
-                           {dmg.x(), dmg.y(), dmg.z()},
-                           {src.x(), src.y(), src.z()},
-                           0.f,
-                           mp.getAppliedImpulse()
-                       });
+    object->engine->queueContactDamage({object,
+                                        {dmg.x(), dmg.y(), dmg.z()},
+                                        {src.x(), src.y(), src.z()},
+                                        0.f,
+                                        mp.getAppliedImpulse()});
 }
 
 void handleInstanceResponse(InstanceObject* instance, const btManifoldPoint& mp,
@@ -696,13 +871,11 @@ void handleInstanceResponse(InstanceObject* instance, const btManifoldPoint& mp,
     ///@ todo Correctness: object damage calculation
     constexpr auto kMinimumDamageImpulse = 500.f;
     const auto hp = std::max(0.f, impulse - kMinimumDamageImpulse);
-    instance->takeDamage({
-                             GameObject::DamageInfo::DamageType::Physics,
-                             {dmg.x(), dmg.y(), dmg.z()},
-                             {dmg.x(), dmg.y(), dmg.z()},
-                             hp,
-                             impulse
-                         });
+    instance->engine->queueContactDamage({instance,
+                                          {dmg.x(), dmg.y(), dmg.z()},
+                                          {dmg.x(), dmg.y(), dmg.z()},
+                                          hp,
+                                          impulse});
 }
 }  // namespace
 
@@ -743,11 +916,28 @@ bool GameWorld::ContactProcessedCallback(btManifoldPoint& mp, void* body0,
     return true;
 }
 
+void GameWorld::queueContactDamage(const ContactDamage& damage) {
+    std::lock_guard<std::mutex> lock(contactDamageMutex);
+    contactDamage.push_back(damage);
+}
+
+void GameWorld::applyContactDamage() {
+    // The tick callback runs on the stepping thread once contacts are done
+    for (const auto& damage : contactDamage) {
+        damage.object->takeDamage({GameObject::DamageInfo::DamageType::Physics,
+                                   damage.location, damage.source,
+                                   damage.hitpoints, damage.impulse});
+    }
+    contactDamage.clear();
+}
+
 void GameWorld::PhysicsTickCallback(btDynamicsWorld* physWorld,
                                     btScalar timeStep) {
     RW_PROFILE_SCOPEC(__func__, MP_CYAN);
     GameWorld* world = static_cast<GameWorld*>(physWorld->getWorldUserInfo());
 
+    world->applyContactDamage();
+
     RW_PROFILE_COUNTER_SET("physicsTick/vehiclePool", world->vehiclePool.objects.size());
     for (auto& p : world->vehiclePool.objects) {
         RW_PROFILE_SCOPEC("VehicleObject", MP_THISTLE1);
@@ -800,7 +990,7 @@ void GameWorld::startCutscene() {
 
     if (cutsceneAudio.length() > 0) {
         sound.pauseAllSounds();
-        sound.playMusic(cutsceneAudio);
+        sound.playMusic(StringId(cutsceneAudio));
     }
 }
 
@@ -822,8 +1012,8 @@ void GameWorld::eraseCutsceneObjects() {
 
 void GameWorld::eraseCutsceneSound() {
     if (cutsceneAudio.length() > 0) {
-        sound.stopMusic(cutsceneAudio);
-        sound.eraseSound(cutsceneAudio);
+        sound.stopMusic(StringId(cutsceneAudio));
+        sound.eraseSound(StringId(cutsceneAudio));
         cutsceneAudio = "";
         sound.resumeAllSounds();
     }
@@ -886,6 +1076,7 @@ void GameWorld::disableAIPaths(ai::NodeType type, const glm::vec3& min,
             }
         }
     }
+    routePlanner.invalidate();
 }
 
 void GameWorld::enableAIPaths(ai::NodeType type, const glm::vec3& min,
@@ -899,6 +1090,7 @@ void GameWorld::enableAIPaths(ai::NodeType type, const glm::vec3& min,
             }
         }
     }
+    routePlanner.invalidate();
 }
 
 void GameWorld::drawAreaIndicator(AreaIndicatorInfo::AreaIndicatorType type,
@@ -908,13 +1100,23 @@ void GameWorld::drawAreaIndicator(AreaIndicatorInfo::AreaIndicatorType type,
 
 void GameWorld::clearTickData() {
     areaIndicators.clear();
+
+    tickArena.reset();
+    for (auto& commands : tickCommands) {
+        commands.getArena().reset();
+    }
+}
+
+FrameArena& GameWorld::getTickArena() {
+    auto commands = TickCommands::current();
+    return commands ? commands->getArena() : tickArena;
 }
 
 void GameWorld::setPaused(bool pause) {
     paused = pause;
     bool resumingCutscene = !pause && !isCutsceneDone();
     if (resumingCutscene) {
-        sound.playMusic(cutsceneAudio);
+        sound.playMusic(StringId(cutsceneAudio));
     } else {
         sound.pause(pause);
     }
@@ -924,13 +1126,8 @@ bool GameWorld::isPaused() const {
     return paused;
 }
 
-void GameWorld::updateEffects() {
-    effects.erase(std::remove_if(effects.begin(), effects.end(),
-                                 [gameTime = getGameTime()](auto& effect) {
-                                     return shouldEffectBeRemoved(effect,
-                                                                  gameTime);
-                                 }),
-                  effects.end());
+void GameWorld::updateEffects(float dt) {
+    particles.update(getGameTime(), dt);
 }
 
 VehicleObject* GameWorld::tryToSpawnVehicle(VehicleGenerator& gen) {
@@ -1042,10 +1239,9 @@ void GameWorld::clearObjectsWithinArea(const glm::vec3 center,
     // explosions, remove all projectiles
 }
 
-std::vector<GameObject *>
-GameWorld::findOverlappingObjects(const glm::vec3 &center,
-                                  float radius) const {
-    std::vector<GameObject*> overlapping;
+std::pmr::vector<GameObject *>
+GameWorld::findOverlappingObjects(const glm::vec3 &center, float radius) {
+    std::pmr::vector<GameObject*> overlapping(&getTickArena());
 
     auto checkObjects = [&](const auto& objects) {
         for (auto& p : objects) {
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <set>
 #include <string>
@@ -18,23 +19,34 @@
 #endif
 
 #include <ai/AIGraph.hpp>
+#include <ai/AIScheduler.hpp>
+#include <ai/RoutePlanner.hpp>
 #include <audio/SoundManager.hpp>
+#include <core/FrameArena.hpp>
 #include <data/Chase.hpp>
+#include <dynamics/HitTest.hpp>
 #include <engine/Garage.hpp>
+#include <engine/InstanceTree.hpp>
 #include <objects/ObjectTypes.hpp>
+#include <render/ParticleSystem.hpp>
 
 class btCollisionDispatcher;
+class btConstraintSolver;
+class btConstraintSolverPoolMt;
 class btDefaultCollisionConfiguration;
 class btDiscreteDynamicsWorld;
 class btDynamicsWorld;
 class btManifoldPoint;
 class btOverlappingPairCallback;
-class btSequentialImpulseConstraintSolver;
 struct btDbvtBroadphase;
 
 class GameState;
 class Garage;
+class GroundHeightField;
+class PhysicsTaskScheduler;
+class JobSystem;
 class Payphone;
+class TickCommands;
 
 namespace ai {
 class PlayerController;
@@ -80,7 +92,11 @@ struct AreaIndicatorInfo {
  */
 class GameWorld {
 public:
-    GameWorld(Logger* log, GameData* dat);
+    /**
+     * @param physicsThreads Number of threads stepping the dynamics world.
+     * More than one thread requires building with ENABLE_PHYSICS_MT.
+     */
+    GameWorld(Logger* log, GameData* dat, int physicsThreads = 1);
 
     ~GameWorld();
 
@@ -109,6 +125,27 @@ public:
      */
     void cleanupTraffic(const ViewCamera& viewCamera);
 
+    /**
+     * @brief updatePhysicsLOD chooses how much physics traffic receives
+     * @param focus The position to measure distances from
+     *
+     * Traffic close to the focus is fully simulated, traffic further away
+     * is moved kinematically along its path and distant traffic is removed
+     * from the dynamics world.
+     */
+    void updatePhysicsLOD(const glm::vec3& focus);
+
+    /**
+     * @brief tickObjects ticks every object in allObjects
+     * @param dt
+     *
+     * With a job system, objects whose next tick only changes themselves
+     * think in parallel first. Their other changes are recorded into
+     * TickCommands and applied in object order once they have all finished,
+     * then the remaining objects are ticked in order.
+     */
+    void tickObjects(float dt);
+
     /**
      * Creates an instance
      */
@@ -190,9 +227,14 @@ public:
     LightFX& createLightEffect();
 
     /**
-     * Allocates a new Particle Effect
+     * Spawns a particle into particles
+     */
+    ParticleSystem::Handle createParticleEffect(const ParticleFX& particle);
+
+    /**
+     * Immediately destroys the given particle
      */
-    ParticleFX& createParticleEffect();
+    void destroyParticleEffect(ParticleSystem::Handle particle);
 
     /**
      * Allocates a new Trail Effect
@@ -223,6 +265,10 @@ public:
     //! Check if the weather conditions are rainy
     bool isRaining() const;
 
+    /**
+     * @return the highest point of the world below z = 100 at pos, or pos
+     * if there is nothing there
+     */
     glm::vec3 getGroundAtPosition(const glm::vec3& pos) const;
 
     float getGameTime() const;
@@ -290,6 +336,11 @@ public:
 
     ObjectPool& getTypeObjectPool(GameObject* object);
 
+    /**
+     * Spatial index of the objects in instancePool, used for culling
+     */
+    InstanceTree instanceTree;
+
     std::vector<ai::PlayerController*> players;
 
     std::vector<std::unique_ptr<Garage>> garages;
@@ -313,21 +364,62 @@ public:
      */
     ai::AIGraph aigraph;
 
+    /**
+     * Routes across aigraph for AI heading to a destination
+     */
+    ai::RoutePlanner routePlanner{aigraph};
+
+    /**
+     * Time slicing of traffic AI updates
+     */
+    ai::AIScheduler aiScheduler;
+
+    /**
+     * Workers for parallel updates, updates run on the calling thread if
+     * this is null
+     */
+    JobSystem* jobSystem = nullptr;
+
     /**
      * Visual Effects
      * @todo Consider using lighter handing mechanism
      */
     std::vector<std::unique_ptr<VisualFX>> effects;
 
+    /**
+     * Particle effects
+     */
+    ParticleSystem particles;
+
     /**
      * Bullet
      */
+#ifdef RW_PHYSICS_MT
+    /// Installed as Bullet's task scheduler while this world exists
+    std::unique_ptr<PhysicsTaskScheduler> taskScheduler;
+#endif
     std::unique_ptr<btDefaultCollisionConfiguration> collisionConfig;
     std::unique_ptr<btCollisionDispatcher> collisionDispatcher;
     std::unique_ptr<btDbvtBroadphase> broadphase;
-    std::unique_ptr<btSequentialImpulseConstraintSolver> solver;
+    std::unique_ptr<btConstraintSolver> solver;
+#ifdef RW_PHYSICS_MT
+    std::unique_ptr<btConstraintSolverPoolMt> solverPool;
+#endif
     std::unique_ptr<btDiscreteDynamicsWorld> dynamicsWorld;
 
+    /**
+     * Held around the collision queries objects may make while thinking in
+     * parallel. Bullet isn't built thread safe and the broadphase shares
+     * one traversal stack between its queries.
+     */
+    mutable std::mutex physicsQueryMutex;
+
+    /**
+     * Cached ground heights used by getGroundAtPosition, guarded by
+     * physicsQueryMutex
+     */
+    mutable std::unique_ptr<GroundHeightField> groundHeights;
+
     /**
      * @brief physicsNearCallback
      * Used to implement uprooting and other physics oddities.
@@ -335,6 +427,20 @@ public:
     static bool ContactProcessedCallback(btManifoldPoint& mp, void* body0,
                                          void* body1);
 
+    struct ContactDamage {
+        GameObject* object;
+        glm::vec3 location;
+        glm::vec3 source;
+        float hitpoints;
+        float impulse;
+    };
+
+    /**
+     * @brief queueContactDamage defers physics damage until the end of the
+     * physics tick, as contacts may be processed on several threads at once.
+     */
+    void queueContactDamage(const ContactDamage& damage);
+
     /**
      * @brief PhysicsTickCallback updates object each physics tick.
      * @param physWorld
@@ -379,15 +485,26 @@ public:
         return areaIndicators;
     }
 
+    /**
+     * Clears the per-tick state and releases the tick arenas
+     */
     void clearTickData();
 
+    /**
+     * Memory for containers that only live during a tick, everything in it
+     * is released by clearTickData
+     * @return the arena of the calling thread's TickCommands, or the
+     * world's arena outside of the parallel part of tickObjects
+     */
+    FrameArena& getTickArena();
+
     void setPaused(bool pause);
     bool isPaused() const;
 
     /**
-     * Clean up old VisualFX
+     * Moves particles and removes the expired ones
      */
-    void updateEffects();
+    void updateEffects(float dt);
 
     /**
      * Attempt to spawn a vehicle at a vehicle generator
@@ -397,8 +514,12 @@ public:
     void clearObjectsWithinArea(const glm::vec3 center, const float radius,
                                 const bool clearParticles);
 
-    std::vector<GameObject*> findOverlappingObjects(const glm::vec3& center,
-                                                    float radius) const;
+    /**
+     * @return the vehicles and characters near center, allocated from the
+     * tick arena
+     */
+    std::pmr::vector<GameObject*> findOverlappingObjects(
+        const glm::vec3& center, float radius);
 
     ai::PlayerController* getPlayer();
 
@@ -408,7 +529,7 @@ public:
         typename std::enable_if<std::is_integral<T2>::value>::type* = nullptr>
     T1 getRandomNumber(T1 min, T2 max) {
         std::uniform_int_distribution<T1> dist(min, static_cast<T1>(max));
-        return dist(randomNumberGen);
+        return dist(getRandomEngine());
     }
 
     template <
@@ -419,7 +540,7 @@ public:
             nullptr>
     T1 getRandomNumber(T1 min, T2 max) {
         std::uniform_real_distribution<T1> dist(min, static_cast<T1>(max));
-        return dist(randomNumberGen);
+        return dist(getRandomEngine());
     }
 
 private:
@@ -430,6 +551,26 @@ private:
 
     std::vector<AreaIndicatorInfo> areaIndicators;
 
+    /**
+     * Reused by doWeaponScan
+     */
+    HitTest::TestResult weaponScanHits;
+
+    /**
+     * Reused by tickObjects
+     */
+    std::vector<GameObject*> parallelObjects;
+    std::vector<GameObject*> serialObjects;
+    std::vector<TickCommands> tickCommands;
+
+    FrameArena tickArena;
+
+    /**
+     * @return the random engine of the calling thread's TickCommands, or
+     * randomNumberGen outside of the parallel part of tickObjects
+     */
+    std::default_random_engine& getRandomEngine();
+
     /**
      * Flag for pausing the simulation
      */
@@ -440,6 +581,19 @@ private:
      */
     std::unique_ptr<btOverlappingPairCallback> _overlappingPairCallback;
 
+    /**
+     * Damage from contacts, collected while the world is being stepped
+     */
+    std::vector<ContactDamage> contactDamage;
+    std::mutex contactDamageMutex;
+
+    void applyContactDamage();
+
+    /**
+     * Drops the cached ground heights under an instance's collision
+     */
+    void invalidateGroundHeights(InstanceObject* instance);
+
     /**
      * Randomness Engine
      */
@@ -0,0 +1,220 @@
+#include "engine/InstanceTree.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include <glm/glm.hpp>
+
+#include <data/Clump.hpp>
+#include <rw/debug.hpp>
+
+#include "data/ModelData.hpp"
+#include "objects/InstanceObject.hpp"
+#include "render/ViewFrustum.hpp"
+
+namespace {
+constexpr uint32_t kLeafSize = 8;
+constexpr size_t kMaxDepth = 64;
+
+/// Bounding radius around the instance position covering all LOD atomics
+bool getInstanceBounds(InstanceObject* instance, float& radius) {
+    if (instance->dynamics || !instance->getAtomic()) {
+        return false;
+    }
+
+    auto modelinfo = instance->getModelInfo<SimpleModelInfo>();
+    if (!modelinfo || modelinfo->getNumAtomics() == 0) {
+        return false;
+    }
+
+    radius = 0.f;
+    for (auto i = 0; i < modelinfo->getNumAtomics(); ++i) {
+        auto atomic = modelinfo->getAtomic(i);
+        if (!atomic || !atomic->getGeometry()) {
+            return false;
+        }
+        const auto& bounds = atomic->getGeometry()->geometryBounds;
+        radius = std::max(radius, glm::length(bounds.center) + bounds.radius);
+    }
+    return true;
+}
+
+bool intersectsBox(const ViewFrustum& frustum, const glm::vec3& min,
+                   const glm::vec3& max) {
+    for (const auto& plane : frustum.planes) {
+        // Corner of the box furthest along the plane normal
+        const glm::vec3 p{plane.normal.x >= 0.f ? max.x : min.x,
+                          plane.normal.y >= 0.f ? max.y : min.y,
+                          plane.normal.z >= 0.f ? max.z : min.z};
+        if (glm::dot(plane.normal, p) + plane.distance < 0.f) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+void InstanceTree::insert(InstanceObject* instance) {
+    float radius;
+    if (!getInstanceBounds(instance, radius)) {
+        dynamicInstances.push_back(instance);
+        return;
+    }
+
+    auto modelinfo = instance->getModelInfo<SimpleModelInfo>();
+    itemIndex[instance] = items.size();
+    items.push_back({instance, instance->getPosition(), radius,
+                     modelinfo->getLargestLodDistance()});
+    dirty = true;
+}
+
+void InstanceTree::remove(InstanceObject* instance) {
+    auto it = itemIndex.find(instance);
+    if (it != itemIndex.end()) {
+        // Leave the node bounds alone until the next rebuild
+        items[it->second].instance = nullptr;
+        itemIndex.erase(it);
+        return;
+    }
+
+    dynamicInstances.erase(
+        std::remove(dynamicInstances.begin(), dynamicInstances.end(), instance),
+        dynamicInstances.end());
+}
+
+void InstanceTree::update(InstanceObject* instance) {
+    auto it = itemIndex.find(instance);
+    if (it == itemIndex.end()) {
+        return;
+    }
+
+    items[it->second].instance = nullptr;
+    itemIndex.erase(it);
+    dynamicInstances.push_back(instance);
+}
+
+void InstanceTree::clear() {
+    items.clear();
+    nodes.clear();
+    itemIndex.clear();
+    dynamicInstances.clear();
+    dirty = false;
+}
+
+void InstanceTree::rebuild() {
+    if (!dirty) {
+        return;
+    }
+
+    items.erase(std::remove_if(items.begin(), items.end(),
+                               [](const Item& item) { return !item.instance; }),
+                items.end());
+
+    nodes.clear();
+    if (!items.empty()) {
+        nodes.reserve(2 * (items.size() / kLeafSize + 1));
+        buildNode(0, static_cast<uint32_t>(items.size()));
+    }
+
+    itemIndex.clear();
+    for (auto i = 0u; i < items.size(); ++i) {
+        itemIndex[items[i].instance] = i;
+    }
+
+    dirty = false;
+}
+
+uint32_t InstanceTree::buildNode(uint32_t begin, uint32_t end) {
+    const auto index = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+
+    Node node;
+    node.min = glm::vec3(std::numeric_limits<float>::max());
+    node.max = glm::vec3(std::numeric_limits<float>::lowest());
+    node.drawDistance = 0.f;
+    glm::vec3 centerMin = node.min;
+    glm::vec3 centerMax = node.max;
+    for (auto i = begin; i < end; ++i) {
+        const auto& item = items[i];
+        node.min = glm::min(node.min, item.center - item.radius);
+        node.max = glm::max(node.max, item.center + item.radius);
+        node.drawDistance = std::max(node.drawDistance, item.drawDistance);
+        centerMin = glm::min(centerMin, item.center);
+        centerMax = glm::max(centerMax, item.center);
+    }
+
+    if (end - begin <= kLeafSize) {
+        node.first = begin;
+        node.count = end - begin;
+        nodes[index] = node;
+        return index;
+    }
+
+    // Split at the median along the longest axis
+    const auto extent = centerMax - centerMin;
+    const int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2)
+                                         : (extent.y > extent.z ? 1 : 2);
+    const auto mid = begin + (end - begin) / 2;
+    std::nth_element(items.begin() + begin, items.begin() + mid,
+                     items.begin() + end,
+                     [axis](const Item& a, const Item& b) {
+                         return a.center[axis] < b.center[axis];
+                     });
+
+    // The left child always follows its parent
+    buildNode(begin, mid);
+    node.first = buildNode(mid, end);
+    node.count = 0;
+    nodes[index] = node;
+    return index;
+}
+
+void InstanceTree::cull(const ViewFrustum& frustum, const glm::vec3& position,
+                        float drawDistanceFactor,
+                        std::pmr::vector<InstanceObject*>& visible) const {
+    visible.clear();
+    if (nodes.empty()) {
+        return;
+    }
+
+    uint32_t stack[kMaxDepth];
+    size_t top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const auto index = stack[--top];
+        const auto& node = nodes[index];
+
+        const auto closest = glm::clamp(position, node.min, node.max);
+        if (glm::distance(closest, position) >
+            node.drawDistance * drawDistanceFactor) {
+            continue;
+        }
+
+        if (!intersectsBox(frustum, node.min, node.max)) {
+            continue;
+        }
+
+        if (node.count == 0) {
+            RW_ASSERT(top + 2 <= kMaxDepth);
+            stack[top++] = node.first;
+            stack[top++] = index + 1;
+            continue;
+        }
+
+        for (auto i = node.first; i < node.first + node.count; ++i) {
+            const auto& item = items[i];
+            if (!item.instance) {
+                continue;
+            }
+            if (glm::distance(item.center, position) >
+                item.drawDistance * drawDistanceFactor) {
+                continue;
+            }
+            if (!frustum.intersects(item.center, item.radius)) {
+                continue;
+            }
+            visible.push_back(item.instance);
+        }
+    }
+}
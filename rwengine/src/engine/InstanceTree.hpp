@@ -0,0 +1,94 @@
+#ifndef _RWENGINE_INSTANCETREE_HPP_
+#define _RWENGINE_INSTANCETREE_HPP_
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+
+class InstanceObject;
+class ViewFrustum;
+
+/**
+ * @brief Bounding volume hierarchy over the static InstanceObjects
+ *
+ * Instances without dynamic object data are indexed by their bounds and
+ * furthest LOD distance, so whole areas of the map can be rejected with a
+ * single test. Instances that can move, or that are moved or change model
+ * after being indexed, are kept in a plain list instead.
+ */
+class InstanceTree {
+public:
+    /**
+     * Adds the instance to the tree if it is static, it is only culled
+     * once the tree has been rebuilt.
+     */
+    void insert(InstanceObject* instance);
+
+    void remove(InstanceObject* instance);
+
+    /**
+     * Called when the instance has moved or changed model, indexed
+     * instances are moved to the dynamic list.
+     */
+    void update(InstanceObject* instance);
+
+    void clear();
+
+    /**
+     * Rebuilds the tree if instances were inserted since the last rebuild,
+     * called from the simulation side so that culling only reads the tree
+     */
+    void rebuild();
+
+    /**
+     * Replaces visible with the indexed instances that may be visible from
+     * position. Nodes outside of the frustum or further away than their
+     * largest LOD distance times drawDistanceFactor are skipped.
+     */
+    void cull(const ViewFrustum& frustum, const glm::vec3& position,
+              float drawDistanceFactor,
+              std::pmr::vector<InstanceObject*>& visible) const;
+
+    /**
+     * @return instances that are not in the tree
+     */
+    const std::vector<InstanceObject*>& getDynamicInstances() const {
+        return dynamicInstances;
+    }
+
+    size_t getStaticCount() const {
+        return itemIndex.size();
+    }
+
+private:
+    struct Item {
+        InstanceObject* instance;
+        glm::vec3 center;
+        float radius;
+        float drawDistance;
+    };
+
+    struct Node {
+        glm::vec3 min;
+        glm::vec3 max;
+        float drawDistance;
+        /// Leaves: first item, otherwise the right child
+        uint32_t first;
+        /// Number of items, 0 for interior nodes
+        uint32_t count;
+    };
+
+    std::vector<Item> items;
+    std::vector<Node> nodes;
+    std::unordered_map<InstanceObject*, size_t> itemIndex;
+    std::vector<InstanceObject*> dynamicInstances;
+    bool dirty = false;
+
+    uint32_t buildNode(uint32_t begin, uint32_t end);
+};
+
+#endif
@@ -990,6 +990,10 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
 
         gamezones[0].insertZone(zone);
     }
+    state.world->data->zoneGrid.clear();
+    if (!gamezones.empty()) {
+        state.world->data->zoneGrid.build(gamezones[0]);
+    }
 
     // Block 12
     BlockSize gangBlockSize;
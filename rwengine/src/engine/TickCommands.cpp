@@ -0,0 +1,68 @@
+#include "engine/TickCommands.hpp"
+
+#include <type_traits>
+#include <utility>
+
+#include <rw/debug.hpp>
+
+#include "engine/GameWorld.hpp"
+
+namespace {
+thread_local TickCommands* currentCommands = nullptr;
+}  // namespace
+
+TickCommands::Scope::Scope(TickCommands& commands)
+    : previous(currentCommands) {
+    currentCommands = &commands;
+}
+
+TickCommands::Scope::~Scope() {
+    currentCommands = previous;
+}
+
+TickCommands* TickCommands::current() {
+    return currentCommands;
+}
+
+void TickCommands::spawn(std::function<void(GameWorld&)> create) {
+    commands.emplace_back(Spawn{std::move(create)});
+}
+
+void TickCommands::destroy(GameObject* object) {
+    commands.emplace_back(Destroy{object});
+}
+
+void TickCommands::damage(const WeaponScan& scan) {
+    commands.emplace_back(Damage{scan});
+}
+
+void TickCommands::setActivity(
+    ai::CharacterController* controller,
+    std::unique_ptr<ai::CharacterController::Activity> activity) {
+    commands.emplace_back(SetActivity{controller, std::move(activity)});
+}
+
+void TickCommands::apply(GameWorld& world) {
+    RW_ASSERT(current() == nullptr);
+
+    for (auto& command : commands) {
+        std::visit(
+            [&](auto& c) {
+                using T = std::decay_t<decltype(c)>;
+                if constexpr (std::is_same_v<T, Spawn>) {
+                    c.create(world);
+                } else if constexpr (std::is_same_v<T, Destroy>) {
+                    world.destroyObjectQueued(c.object);
+                } else if constexpr (std::is_same_v<T, Damage>) {
+                    world.doWeaponScan(c.scan);
+                } else {
+                    if (c.controller->getCurrentActivity() != nullptr) {
+                        c.controller->skipActivity();
+                    }
+                    c.controller->setNextActivity(std::move(c.activity));
+                }
+            },
+            command);
+    }
+    commands.clear();
+}
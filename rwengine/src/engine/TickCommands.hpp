@@ -0,0 +1,112 @@
+#ifndef _RWENGINE_TICKCOMMANDS_HPP_
+#define _RWENGINE_TICKCOMMANDS_HPP_
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <variant>
+#include <vector>
+
+#include <ai/CharacterController.hpp>
+#include <core/FrameArena.hpp>
+#include <items/Weapon.hpp>
+
+class GameObject;
+class GameWorld;
+
+/**
+ * @brief Changes to the world recorded by objects ticking in parallel
+ *
+ * While objects think in parallel they may only change themselves, other
+ * changes are recorded into the TickCommands of the thread instead. The
+ * commands are applied on the main thread afterwards, buffers in the order
+ * of the objects they were recorded for, so the outcome doesn't depend on
+ * how the objects were scheduled.
+ */
+class TickCommands {
+public:
+    /**
+     * Makes the buffer current for the calling thread until destroyed
+     */
+    class Scope {
+    public:
+        explicit Scope(TickCommands& commands);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        TickCommands* previous;
+    };
+
+    /**
+     * @return the buffer recording changes made by the calling thread, or
+     * nullptr if changes should be made immediately
+     */
+    static TickCommands* current();
+
+    /**
+     * Random numbers for the objects recording into this buffer, seeded on
+     * the main thread before they think
+     */
+    std::default_random_engine random;
+
+    /**
+     * Memory for the temporary containers of the objects recording into
+     * this buffer, reset with the world's tick arena
+     */
+    FrameArena& getArena() {
+        return *arena;
+    }
+
+    /**
+     * Creates objects, called with the world when applied
+     */
+    void spawn(std::function<void(GameWorld&)> create);
+
+    void destroy(GameObject* object);
+
+    void damage(const WeaponScan& scan);
+
+    /**
+     * Replaces the activity of another character, skipping its current one
+     */
+    void setActivity(ai::CharacterController* controller,
+                     std::unique_ptr<ai::CharacterController::Activity> activity);
+
+    /**
+     * Applies the commands in the order they were recorded and clears the
+     * buffer
+     */
+    void apply(GameWorld& world);
+
+    bool empty() const {
+        return commands.empty();
+    }
+
+private:
+    struct Spawn {
+        std::function<void(GameWorld&)> create;
+    };
+
+    struct Destroy {
+        GameObject* object;
+    };
+
+    struct Damage {
+        WeaponScan scan;
+    };
+
+    struct SetActivity {
+        ai::CharacterController* controller;
+        std::unique_ptr<ai::CharacterController::Activity> activity;
+    };
+
+    using Command = std::variant<Spawn, Destroy, Damage, SetActivity>;
+
+    std::vector<Command> commands;
+    std::unique_ptr<FrameArena> arena = std::make_unique<FrameArena>();
+};
+
+#endif
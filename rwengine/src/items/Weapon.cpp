@@ -1,6 +1,7 @@
 #include "items/Weapon.hpp"
 
 #include <algorithm>
+#include <mutex>
 
 #include <glm/glm.hpp>
 
@@ -9,6 +10,7 @@
 #include <data/Clump.hpp>
 
 #include "engine/GameWorld.hpp"
+#include "engine/TickCommands.hpp"
 #include "objects/CharacterObject.hpp"
 #include "objects/ProjectileObject.hpp"
 
@@ -18,7 +20,7 @@ bool WeaponScan::doesDamage(GameObject* target) const {
 }
 
 void Weapon::fireHitscan(WeaponData* weapon, CharacterObject* owner) {
-    auto handFrame = owner->getClump()->findFrame("srhand");
+    auto handFrame = owner->getClump()->findFrame("srhand"_nid);
     glm::mat4 handMatrix = handFrame->getWorldTransform();
 
     const auto& raydirection = owner->getLookDirection();
@@ -41,17 +43,27 @@ void Weapon::fireProjectile(WeaponData* weapon, CharacterObject* owner,
 
     force = std::max(0.1f, force);
 
-    auto projectile = std::make_unique<ProjectileObject>(
-        owner->engine, fireOrigin,
-        ProjectileObject::ProjectileInfo{
-            pt, direction,
-            17.f * force,  /// @todo pull a better velocity from somewhere
-            3.5f, weapon});
-    auto ptr = projectile.get();
-
-    auto& pool = owner->engine->getTypeObjectPool(ptr);
-    pool.insert(std::move(projectile));
-    owner->engine->allObjects.push_back(ptr);
+    const ProjectileObject::ProjectileInfo info{
+        pt, direction,
+        17.f * force,  /// @todo pull a better velocity from somewhere
+        3.5f, weapon};
+
+    auto spawn = [fireOrigin, info](GameWorld& world) {
+        auto projectile =
+            std::make_unique<ProjectileObject>(&world, fireOrigin, info);
+        auto ptr = projectile.get();
+
+        auto& pool = world.getTypeObjectPool(ptr);
+        pool.insert(std::move(projectile));
+        world.allObjects.push_back(ptr);
+    };
+
+    // The projectile adds itself to the dynamics world
+    if (auto commands = TickCommands::current()) {
+        commands->spawn(spawn);
+    } else {
+        spawn(*owner->engine);
+    }
 }
 
 void Weapon::meleeHit(WeaponData* weapon, CharacterObject* character) {
@@ -69,7 +81,11 @@ bool Weapon::targetOnGround(WeaponData *weapon, CharacterObject *character) {
     const auto center = character->getPosition() + character->getRotation()
                                                    * weapon->fireOffset;
     HitTest test {*character->engine->dynamicsWorld};
-    const auto result = test.sphereTest(center, weapon->meleeRadius);
+    HitTest::TestResult result(&character->engine->getTickArena());
+    {
+        std::lock_guard<std::mutex> lock(character->engine->physicsQueryMutex);
+        test.sphereTest(center, weapon->meleeRadius, result);
+    }
     bool ground = false;
     for (const auto& r : result) {
         if (r.object == character) {
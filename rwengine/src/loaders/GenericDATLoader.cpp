@@ -14,7 +14,7 @@
 
 void GenericDATLoader::loadDynamicObjects(
     const std::string& name,
-    std::unordered_map<std::string, DynamicObjectData>& data) {
+    std::unordered_map<NameId, DynamicObjectData>& data) {
     std::ifstream dfile(name.c_str());
 
     if (dfile.is_open()) {
@@ -58,7 +58,7 @@ void GenericDATLoader::loadDynamicObjects(
 
             RW_CHECK(ss.eof() || ss.good(), "Loading dynamicsObject data file " << name << " failed");
 
-            data.emplace(modelName, std::move(dyndata));
+            data.emplace(NameId::intern(modelName), std::move(dyndata));
         }
     }
 }
@@ -7,6 +7,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include <rw/StringId.hpp>
+
 struct DynamicObjectData;
 struct WeaponData;
 struct VehicleInfo;
@@ -15,7 +17,7 @@ class GenericDATLoader {
 public:
     void loadDynamicObjects(
         const std::string& name,
-        std::unordered_map<std::string, DynamicObjectData>& data);
+        std::unordered_map<NameId, DynamicObjectData>& data);
 
     void loadWeapons(const std::string& name,
                      std::vector<WeaponData>& weaponData);
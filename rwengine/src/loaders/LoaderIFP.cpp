@@ -133,11 +133,8 @@ bool LoaderIFP::loadFromMemory(char* data) {
 
             data_offs = start + sizeof(CPAN) + cpan->base.size;
 
-            std::string framename(frames->name);
-            std::transform(framename.begin(), framename.end(),
-                           framename.begin(), ::tolower);
-
-            animation->bones.emplace(framename, std::move(boneData));
+            animation->bones.emplace(NameId::intern(frames->name),
+                                     std::move(boneData));
         }
 
         data_offs = animstart + animroot->base.size;
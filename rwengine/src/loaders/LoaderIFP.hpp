@@ -10,6 +10,7 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/vec3.hpp>
 
+#include <rw/StringId.hpp>
 #include <rw/forward.hpp>
 
 struct AnimationKeyframe {
@@ -67,7 +68,7 @@ struct AnimationBone {
  */
 struct Animation {
     std::string name;
-    std::unordered_map<std::string, AnimationBone> bones;
+    std::unordered_map<NameId, AnimationBone> bones;
 
     ~Animation() = default;
 
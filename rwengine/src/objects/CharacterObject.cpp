@@ -102,6 +102,7 @@ void CharacterObject::createActor(const glm::vec2& size) {
             physObject.get(), btBroadphaseProxy::KinematicFilter,
             btBroadphaseProxy::StaticFilter | btBroadphaseProxy::SensorTrigger);
         engine->dynamicsWorld->addAction(physCharacter.get());
+        physicsLOD = PhysicsLOD::Full;
     }
 }
 
@@ -243,7 +244,7 @@ glm::vec3 CharacterObject::updateMovementAnimation(float dt) {
     if (movementAnimation != animations->animation(AnimCycle::Idle) &&
         !modelroot->getChildren().empty()) {
         const auto& root = modelroot->getChildren()[0];
-        auto it = movementAnimation->bones.find(root->getName());
+        auto it = movementAnimation->bones.find(root->getNameId());
         if (it != movementAnimation->bones.end()) {
             auto& rootBone = it->second;
             float step = dt;
@@ -286,7 +287,14 @@ glm::vec3 CharacterObject::updateMovementAnimation(float dt) {
 
 void CharacterObject::tick(float dt) {
     if (controller) {
-        controller->update(dt);
+        // Traffic may be updated less often, with the time it missed
+        float controllerDt = dt;
+        if (getLifetime() != GameObject::TrafficLifetime ||
+            engine->aiScheduler.schedule(controller->scheduleSlot,
+                                         getGameObjectID(), getPosition(), dt,
+                                         controllerDt)) {
+            controller->update(controllerDt);
+        }
 
         // Reset back to idle cycle when not in an activity
         if (controller->getCurrentActivity() == nullptr) {
@@ -303,11 +311,47 @@ void CharacterObject::tick(float dt) {
     }
 }
 
+bool CharacterObject::canTickInParallel() const {
+    return controller && controller->canThinkInParallel();
+}
+
 void CharacterObject::tickPhysics(float dt) {
     if (physCharacter) {
         auto s = currenteMovementStep * dt;
-        physCharacter->setWalkDirection(btVector3(s.x, s.y, s.z));
+        if (physicsLOD == PhysicsLOD::Disabled) {
+            // Without the controller there is nothing to walk into
+            auto origin = physObject->getWorldTransform().getOrigin();
+            physCharacter->warp(origin + btVector3(s.x, s.y, s.z));
+        } else {
+            physCharacter->setWalkDirection(btVector3(s.x, s.y, s.z));
+        }
+    }
+}
+
+void CharacterObject::setPhysicsLOD(PhysicsLOD lod) {
+    if (!physCharacter) {
+        return;
+    }
+
+    const bool enabled = lod != PhysicsLOD::Disabled;
+    if (enabled == (physicsLOD != PhysicsLOD::Disabled)) {
+        physicsLOD = lod;
+        return;
     }
+
+    if (enabled) {
+        engine->dynamicsWorld->addCollisionObject(
+            physObject.get(), btBroadphaseProxy::KinematicFilter,
+            btBroadphaseProxy::StaticFilter | btBroadphaseProxy::SensorTrigger);
+        engine->dynamicsWorld->addAction(physCharacter.get());
+        physCharacter->reset(engine->dynamicsWorld.get());
+    } else {
+        physCharacter->setWalkDirection(btVector3(0.f, 0.f, 0.f));
+        engine->dynamicsWorld->removeAction(physCharacter.get());
+        engine->dynamicsWorld->removeCollisionObject(physObject.get());
+    }
+
+    physicsLOD = lod;
 }
 
 void CharacterObject::setRotation(const glm::quat& orientation) {
@@ -434,6 +478,8 @@ void CharacterObject::setPosition(const glm::vec3& pos) {
             realPos = engine->getGroundAtPosition(pos);
         }
         btVector3 bpos(realPos.x, realPos.y, realPos.z);
+        // Queries from other threads may be reading the ghost's transform
+        std::lock_guard<std::mutex> lock(engine->physicsQueryMutex);
         physCharacter->warp(bpos);
     }
     position = realPos;
@@ -10,6 +10,7 @@
 #include <rw/forward.hpp>
 
 #include <data/AnimGroup.hpp>
+#include <dynamics/PhysicsLOD.hpp>
 #include <objects/GameObject.hpp>
 
 namespace ai {
@@ -76,6 +77,8 @@ private:
     glm::vec3 updateMovementAnimation(float dt);
     glm::vec3 currenteMovementStep{};
 
+    PhysicsLOD physicsLOD = PhysicsLOD::Full;
+
     AnimCycle cycle_ = AnimCycle::Idle;
 
 public:
@@ -107,8 +110,23 @@ public:
 
     void tick(float dt) override;
 
+    bool canTickInParallel() const override;
+
     void tickPhysics(float dt);
 
+    /**
+     * @brief setPhysicsLOD moves the character between the physics tiers
+     *
+     * Characters are always kinematic, so the Kinematic tier is the same as
+     * Full. Disabled characters are removed from the dynamics world and
+     * walk without checking for collisions.
+     */
+    void setPhysicsLOD(PhysicsLOD lod);
+
+    PhysicsLOD getPhysicsLOD() const {
+        return physicsLOD;
+    }
+
     const CharacterState& getCurrentState() const {
         return currentState;
     }
@@ -219,6 +219,14 @@ public:
 
     virtual void tick(float dt) = 0;
 
+    /**
+     * @return true if the next tick only changes the object itself, so it
+     * may run alongside other objects. See GameWorld::tickObjects
+     */
+    virtual bool canTickInParallel() const {
+        return false;
+    }
+
     enum ObjectLifetime {
         /// lifetime has not been set
         UnknownLifetime,
@@ -174,6 +174,10 @@ void InstanceObject::changeModel(BaseModelInfo* incoming, int atomicNumber) {
             body->createPhysicsBody(this, collision, dynamics);
         }
     }
+
+    if (engine) {
+        engine->instanceTree.update(this);
+    }
 }
 
 void InstanceObject::setPosition(const glm::vec3& pos) {
@@ -185,6 +189,10 @@ void InstanceObject::setPosition(const glm::vec3& pos) {
         atomic_->getFrame()->setTranslation(pos);
     }
     GameObject::setPosition(pos);
+
+    if (engine) {
+        engine->instanceTree.update(this);
+    }
 }
 
 void InstanceObject::setRotation(const glm::quat& r) {
@@ -207,7 +207,6 @@ PickupObject::BehaviourFlags PickupObject::defaultBehaviourFlags(
 PickupObject::PickupObject(GameWorld* world, const glm::vec3& position,
                            BaseModelInfo* modelinfo, PickupType type)
     : GameObject(world, position, glm::quat{1.0f, 0.0f, 0.0f, 0.0f}, modelinfo)
-    , m_corona(world->createParticleEffect())
     , m_type(type) {
     btTransform tf;
     tf.setIdentity();
@@ -250,20 +249,24 @@ PickupObject::PickupObject(GameWorld* world, const glm::vec3& position,
     else if (modelinfo->name == "health" || modelinfo->name == "bonus")
         m_colourId = 13;
 
-    m_corona.position = getPosition();
-    m_corona.direction = glm::vec3(0.f, 0.f, 1.f);
-    m_corona.orientation = ParticleFX::Camera;
+    ParticleFX corona;
+    corona.position = getPosition();
+    corona.direction = glm::vec3(0.f, 0.f, 1.f);
+    corona.orientation = ParticleFX::Camera;
+    // Shown once the pickup is enabled
+    corona.size = glm::vec2(0.f, 0.f);
 
     // @todo float package should float on the water
     if (m_type == FloatingPackage) {
         // verify offset and texture?
-        m_corona.position += glm::vec3(0.f, 0.f, 0.7f);
-        m_corona.texture =
-            engine->data->findSlotTexture("particle", "coronastar");
+        corona.position += glm::vec3(0.f, 0.f, 0.7f);
+        corona.texture =
+            engine->data->findSlotTexture("particle"_nid, "coronastar"_nid);
     } else {
-        m_corona.texture =
-            engine->data->findSlotTexture("particle", "coronaringa");
+        corona.texture =
+            engine->data->findSlotTexture("particle"_nid, "coronaringa"_nid);
     }
+    m_corona = engine->createParticleEffect(corona);
 
     respawn = defaultDoesRespawn(m_type);
     respawnTime = defaultRespawnTime(m_type);
@@ -280,7 +283,7 @@ PickupObject::PickupObject(GameWorld* world, const glm::vec3& position,
 PickupObject::~PickupObject() {
     if (m_ghost) {
         setEnabled(false);
-        engine->destroyEffect(m_corona);
+        engine->destroyParticleEffect(m_corona);
     }
 }
 
@@ -313,8 +316,9 @@ void PickupObject::tick(float dt) {
     float red = static_cast<float>((*colour >> 16) & 0xFF);
     float green = static_cast<float>((*colour >> 8) & 0xFF);
     float blue = static_cast<float>(*colour & 0xFF);
-    m_corona.colour =
-        glm::vec4(red / 255.f, green / 255.f, blue / 255.f, 1.f) * colourValue;
+    engine->particles.setColour(
+        m_corona,
+        glm::vec4(red / 255.f, green / 255.f, blue / 255.f, 1.f) * colourValue);
 
     if (m_enabled) {
         static constexpr float kRotationSpeedCoeff = 3.0f;
@@ -380,10 +384,10 @@ void PickupObject::setEnabled(bool enabled) {
     if (!m_enabled && enabled) {
         engine->dynamicsWorld->addCollisionObject(
             m_ghost.get(), btBroadphaseProxy::SensorTrigger);
-        m_corona.size = glm::vec2(1.5f, 1.5f);
+        engine->particles.setSize(m_corona, glm::vec2(1.5f, 1.5f));
     } else if (m_enabled && !enabled) {
         engine->dynamicsWorld->removeCollisionObject(m_ghost.get());
-        m_corona.size = glm::vec2(0.f, 0.f);
+        engine->particles.setSize(m_corona, glm::vec2(0.f, 0.f));
     }
 
     m_enabled = enabled;
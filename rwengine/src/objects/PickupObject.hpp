@@ -5,7 +5,7 @@
 
 #include <rw/debug.hpp>
 
-#include <render/VisualFX.hpp>
+#include <render/ParticleSystem.hpp>
 #include <objects/GameObject.hpp>
 
 
@@ -120,7 +120,7 @@ private:
     bool m_enabled = false;
     float m_enableTimer = 0.f;
     bool m_collected = false;
-    ParticleFX& m_corona;
+    ParticleSystem::Handle m_corona{};
     short m_colourId = 0;
     bool respawn = false;
     float respawnTime{};
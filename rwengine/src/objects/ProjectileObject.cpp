@@ -84,9 +84,10 @@ void ProjectileObject::explode() {
                            0.f});
         }
 
-        auto& explosion = engine->createParticleEffect();
+        ParticleFX explosion;
 
-        auto texPtr = engine->data->findSlotTexture("particle", "explo02");
+        auto texPtr =
+            engine->data->findSlotTexture("particle"_nid, "explo02"_nid);
         explosion.texture = texPtr;
         explosion.size = glm::vec2(exp_size);
         explosion.starttime = engine->getGameTime();
@@ -95,6 +96,7 @@ void ProjectileObject::explode() {
         explosion.colour = glm::vec4(1.0f);
         explosion.position = getPosition();
         explosion.direction = glm::vec3(0.f, 0.f, 1.f);
+        engine->createParticleEffect(explosion);
 
         _exploded = true;
         engine->destroyObjectQueued(this);
@@ -191,7 +191,7 @@ void VehicleObject::setupModel() {
     const auto vehicleInfo = getModelInfo<VehicleModelInfo>();
     const auto isBoat = (vehicleInfo->vehicletype_ == VehicleModelInfo::BOAT);
     const std::string baseName = isBoat ? "boat" : "chassis";
-    const auto dummy = getClump()->findFrame("chassis_dummy");
+    const auto dummy = getClump()->findFrame("chassis_dummy"_nid);
 
     for (const auto& atomic : getClump()->getAtomics()) {
         auto frame = atomic->getFrame().get();
@@ -324,10 +324,14 @@ void VehicleObject::tick(float dt) {
 }
 
 void VehicleObject::tickPhysics(float dt) {
-    RW_UNUSED(dt);
-
     static constexpr float steeringWeight = 1.f/0.35f;
 
+    if (physicsLOD != PhysicsLOD::Full) {
+        tickPathFollowing(dt);
+        updateSeatOccupants();
+        return;
+    }
+
     if (physVehicle) {
         // todo: a real engine function
         float velFac = info->handling.maxVelocity;
@@ -447,22 +451,7 @@ void VehicleObject::tickPhysics(float dt) {
             }
         }
 
-        // Update passenger positions
-        for (auto& [seatId, objectPtr] : seatOccupants) {
-            auto character = static_cast<CharacterObject*>(objectPtr);
-
-            glm::vec3 passPosition{};
-            if (character->isEnteringOrExitingVehicle()) {
-                passPosition = getSeatEntryPositionWorld(seatId);
-            } else {
-                passPosition = getPosition();
-                if (seatId < info->seats.size()) {
-                    passPosition +=
-                        getRotation() * (info->seats[seatId].offset);
-                }
-            }
-            objectPtr->updateTransform(passPosition, getRotation());
-        }
+        updateSeatOccupants();
 
         if (getVehicle()->vehicletype_ == VehicleModelInfo::BOAT) {
             if (isInWater()) {
@@ -617,6 +606,124 @@ void VehicleObject::tickPhysics(float dt) {
     }
 }
 
+void VehicleObject::updateSeatOccupants() {
+    for (auto& [seatId, objectPtr] : seatOccupants) {
+        auto character = static_cast<CharacterObject*>(objectPtr);
+
+        glm::vec3 passPosition{};
+        if (character->isEnteringOrExitingVehicle()) {
+            passPosition = getSeatEntryPositionWorld(seatId);
+        } else {
+            passPosition = getPosition();
+            if (seatId < info->seats.size()) {
+                passPosition += getRotation() * (info->seats[seatId].offset);
+            }
+        }
+        objectPtr->updateTransform(passPosition, getRotation());
+    }
+}
+
+void VehicleObject::setPhysicsLOD(PhysicsLOD lod) {
+    auto body = collision->getBulletBody();
+    if (lod == physicsLOD || body == nullptr) {
+        return;
+    }
+
+    // The hinges of opened or broken parts are attached to the body
+    if (lod != PhysicsLOD::Full &&
+        std::any_of(dynamicParts.begin(), dynamicParts.end(),
+                    [](const auto& p) { return p.second.body != nullptr; })) {
+        return;
+    }
+
+    auto& world = *engine->dynamicsWorld;
+    if (physicsLOD == PhysicsLOD::Full) {
+        world.removeAction(physVehicle.get());
+        pathHeightOffset = hasPathTarget ? position.z - pathTarget.z : 0.f;
+    }
+    if (physicsLOD != PhysicsLOD::Disabled) {
+        world.removeRigidBody(body);
+    }
+
+    btTransform transform;
+    body->getMotionState()->getWorldTransform(transform);
+    body->setWorldTransform(transform);
+    body->setInterpolationWorldTransform(transform);
+    body->setAngularVelocity(btVector3(0.f, 0.f, 0.f));
+    body->setLinearVelocity(btVector3(0.f, 0.f, 0.f));
+
+    switch (lod) {
+        case PhysicsLOD::Full: {
+            btVector3 inertia;
+            body->getCollisionShape()->calculateLocalInertia(
+                info->handling.mass, inertia);
+            body->setMassProps(info->handling.mass, inertia);
+            body->setCollisionFlags(body->getCollisionFlags() &
+                                    ~btCollisionObject::CF_KINEMATIC_OBJECT);
+            body->updateInertiaTensor();
+
+            // Carry the speed along the path over into the simulation
+            if (hasPathTarget) {
+                auto velocity =
+                    getRotation() * glm::vec3(0.f, pathSpeed, 0.f);
+                body->setLinearVelocity(
+                    btVector3(velocity.x, velocity.y, velocity.z));
+            }
+
+            world.addRigidBody(body);
+            physVehicle->resetSuspension();
+            world.addAction(physVehicle.get());
+        } break;
+        case PhysicsLOD::Kinematic:
+            // Kinematic bodies push dynamic bodies, but aren't pushed back
+            body->setMassProps(0.f, btVector3(0.f, 0.f, 0.f));
+            body->setCollisionFlags(body->getCollisionFlags() |
+                                    btCollisionObject::CF_KINEMATIC_OBJECT);
+            body->updateInertiaTensor();
+            world.addRigidBody(body);
+            break;
+        case PhysicsLOD::Disabled:
+            break;
+    }
+
+    physicsLOD = lod;
+}
+
+void VehicleObject::setPathTarget(const glm::vec3& target, float speed) {
+    if (!hasPathTarget && physicsLOD != PhysicsLOD::Full) {
+        pathHeightOffset = position.z - target.z;
+    }
+    pathTarget = target;
+    pathSpeed = speed;
+    hasPathTarget = true;
+}
+
+void VehicleObject::tickPathFollowing(float dt) {
+    if (!hasPathTarget || pathSpeed <= 0.f) {
+        return;
+    }
+
+    const auto delta = glm::vec2(pathTarget - position);
+    const auto distance = glm::length(delta);
+    if (distance < 0.01f) {
+        return;
+    }
+
+    const auto direction = delta / distance;
+    const auto step = std::min(distance, pathSpeed * dt);
+
+    // Drive flat towards the target, following the height of the road
+    auto newPosition = position + glm::vec3(direction * step, 0.f);
+    newPosition.z = glm::mix(position.z, pathTarget.z + pathHeightOffset,
+                             step / distance);
+    const auto heading =
+        glm::angleAxis(std::atan2(-direction.x, direction.y),
+                       glm::vec3(0.f, 0.f, 1.f));
+
+    // The kinematic body reads the new transform through its motion state
+    updateTransform(newPosition, heading);
+}
+
 bool VehicleObject::isFlipped() const {
     auto forward = getRotation() * glm::vec3(0.f, 0.f, 1.f);
     return forward.z <= -0.97f;
@@ -628,6 +735,9 @@ bool VehicleObject::isUpright() const {
 }
 
 float VehicleObject::getVelocity() const {
+    if (physicsLOD != PhysicsLOD::Full) {
+        return hasPathTarget ? pathSpeed : 0.f;
+    }
     if (physVehicle) {
         return (physVehicle->getCurrentSpeedKmHour() * 1000.f) / (60.f * 60.f);
     }
@@ -856,8 +966,8 @@ void VehicleObject::registerPart(ModelFrame* mf) {
     RW_CHECK(dummynameend != std::string::npos,
              "Can't create part from non-dummy");
     auto dummyname = mf->getName().substr(0, dummynameend);
-    auto normalframe = mf->findDescendant(dummyname + "_hi_ok");
-    auto damageframe = mf->findDescendant(dummyname + "_hi_dam");
+    auto normalframe = mf->findDescendant(NameId(dummyname + "_hi_ok"));
+    auto damageframe = mf->findDescendant(NameId(dummyname + "_hi_dam"));
 
     if (normalframe == nullptr && damageframe == nullptr) {
         // Not actually a useful part, just a dummy.
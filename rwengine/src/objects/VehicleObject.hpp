@@ -19,6 +19,7 @@
 #include <glm/vec3.hpp>
 
 #include <data/ModelData.hpp>
+#include <dynamics/PhysicsLOD.hpp>
 #include <objects/GameObject.hpp>
 #include <objects/VehicleInfo.hpp>
 
@@ -52,6 +53,13 @@ private:
 
     std::array<Atomic*, 6> extras_{};
 
+    PhysicsLOD physicsLOD = PhysicsLOD::Full;
+    glm::vec3 pathTarget{};
+    float pathSpeed{0.f};
+    bool hasPathTarget = false;
+    /// Height of the body above the path while not fully simulated
+    float pathHeightOffset{0.f};
+
 public:
     float health{1000.f};
 
@@ -151,6 +159,34 @@ public:
 
     void tickPhysics(float dt);
 
+    /**
+     * @brief setPhysicsLOD moves the vehicle between the physics tiers
+     *
+     * Outside of the Full tier the raycast vehicle is not simulated and the
+     * vehicle is moved towards its path target instead. Vehicles with
+     * hinged parts always stay fully simulated.
+     */
+    void setPhysicsLOD(PhysicsLOD lod);
+
+    PhysicsLOD getPhysicsLOD() const {
+        return physicsLOD;
+    }
+
+    /**
+     * @brief setPathTarget sets the point the vehicle is driving to
+     *
+     * Used to move the vehicle when it is not fully simulated.
+     */
+    void setPathTarget(const glm::vec3& target, float speed);
+
+    void clearPathTarget() {
+        hasPathTarget = false;
+    }
+
+    const glm::vec3& getPathTarget() const {
+        return pathTarget;
+    }
+
     bool isFlipped() const;
 
     bool isUpright() const;
@@ -250,6 +286,8 @@ private:
     void registerPart(ModelFrame* mf);
     void createObjectHinge(Part* part);
     void destroyObjectHinge(Part* part);
+    void tickPathFollowing(float dt);
+    void updateSeatOccupants();
 };
 
 #endif
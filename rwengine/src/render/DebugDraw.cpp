@@ -1,5 +1,6 @@
 #include "render/DebugDraw.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include <glm/glm.hpp>
@@ -15,6 +16,7 @@
 #include <data/Clump.hpp>
 #include <gl/DrawBuffer.hpp>
 #include <gl/GeometryBuffer.hpp>
+#include <gl/StreamBuffer.hpp>
 #include <gl/gl_core_3_3.h>
 #include <rw/debug.hpp>
 
@@ -62,20 +64,31 @@ void DebugDraw::flush(GameRenderer &renderer) {
         return;
     }
 
-    renderer.getRenderer().useProgram(shaderProgram);
+    auto& r = renderer.getRenderer();
+    auto& stream = r.getStreamBuffer();
+    r.useProgram(shaderProgram);
 
-    lineBuff->uploadVertices(lines);
-    dbuff->addGeometry(lineBuff.get());
+    if (!streamBound) {
+        stream.bind(*dbuff, GeometryVertex::vertex_attributes());
+        streamBound = true;
+    }
 
     Renderer::DrawParameters dp;
     dp.textures = {{texture}};
     dp.ambient = 1.f;
     dp.colour = glm::u8vec4(255, 255, 255, 255);
-    dp.start = 0;
-    dp.count = lines.size();
     dp.diffuse = 1.f;
 
-    renderer.getRenderer().drawArrays(glm::mat4(1.f), dbuff.get(), dp);
+    // Physics debug lines can exceed a single allocation, keep whole lines
+    const auto maxVertices =
+        stream.getMaxVertices(sizeof(GeometryVertex)) & ~size_t{1};
+    for (size_t first = 0; first < lines.size(); first += maxVertices) {
+        const auto count = std::min(maxVertices, lines.size() - first);
+        const auto allocation = stream.upload(lines.data() + first, count);
+        dp.start = allocation.baseVertex;
+        dp.count = count;
+        r.drawArrays(glm::mat4(1.f), dbuff.get(), dp);
+    }
 
     renderer.getRenderer().invalidate();
 
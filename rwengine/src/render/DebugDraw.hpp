@@ -18,7 +18,6 @@
 class btVector3;
 class DrawBuffer;
 class GameRenderer;
-class GeometryBuffer;
 struct GeometryVertex;
 
 class DebugDraw final : public btIDebugDraw {
@@ -53,8 +52,9 @@ protected:
 
     std::vector<GeometryVertex> lines;
     size_t maxlines;
-    std::unique_ptr<GeometryBuffer> lineBuff = std::make_unique<GeometryBuffer>();
     std::unique_ptr<DrawBuffer> dbuff = std::make_unique<DrawBuffer>();
+    /// Set once dbuff points at the renderer's stream buffer
+    bool streamBound = false;
 
     //Ownership is handled by worldProg in renderer
     Renderer::ShaderProgram *shaderProgram = nullptr;
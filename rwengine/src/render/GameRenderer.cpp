@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <cmath>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -56,8 +57,16 @@ GameRenderer::GameRenderer(Logger* log, GameData* _data)
     renderer->setProgramBlockBinding(worldProg.get(), "SceneData", 1);
     renderer->setProgramBlockBinding(worldProg.get(), "ObjectData", 2);
 
+    worldInstancedProg =
+        renderer->createShader(GameShaders::WorldObjectInstanced::VertexShader,
+                               GameShaders::WorldObject::FragmentShader);
+
+    renderer->setUniformTexture(worldInstancedProg.get(), "texture", 0);
+    renderer->setProgramBlockBinding(worldInstancedProg.get(), "SceneData", 1);
+    renderer->setProgramBlockBinding(worldInstancedProg.get(), "ObjectData", 2);
+
     particleProg =
-        renderer->createShader(GameShaders::WorldObject::VertexShader,
+        renderer->createShader(GameShaders::Particle::VertexShader,
                                GameShaders::Particle::FragmentShader);
 
     renderer->setUniformTexture(particleProg.get(), "texture", 0);
@@ -68,6 +77,9 @@ GameRenderer::GameRenderer(Logger* log, GameData* _data)
                                      GameShaders::Sky::FragmentShader);
 
     renderer->setProgramBlockBinding(skyProg.get(), "SceneData", 1);
+    skyTopColour = renderer->getUniform<glm::vec4>(skyProg.get(), "TopColor");
+    skyBottomColour =
+        renderer->getUniform<glm::vec4>(skyProg.get(), "BottomColor");
 
     postProg =
         renderer->createShader(GameShaders::DefaultPostProcess::VertexShader,
@@ -162,7 +174,10 @@ GameRenderer::GameRenderer(Logger* log, GameData* _data)
     ssRectProg =
         renderer->createShader(GameShaders::ScreenSpaceRect::VertexShader,
                                GameShaders::ScreenSpaceRect::FragmentShader);
-    renderer->setUniform(ssRectProg.get(), "texture", 0);
+    renderer->setUniformTexture(ssRectProg.get(), "texture", 0);
+    ssRectColour = renderer->getUniform<glm::vec4>(ssRectProg.get(), "colour");
+    ssRectSize = renderer->getUniform<glm::vec2>(ssRectProg.get(), "size");
+    ssRectOffset = renderer->getUniform<glm::vec2>(ssRectProg.get(), "offset");
 }
 
 GameRenderer::~GameRenderer() {
@@ -252,9 +267,8 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
     dp.count = skydomeSegments * skydomeRows * 6;
 
     renderer->useProgram(skyProg.get());
-    renderer->setUniform(skyProg.get(), "TopColor",
-                         glm::vec4{weather.skyTopColor, 1.f});
-    renderer->setUniform(skyProg.get(), "BottomColor",
+    renderer->setUniform(skyTopColour, glm::vec4{weather.skyTopColor, 1.f});
+    renderer->setUniform(skyBottomColour,
                          glm::vec4{weather.skyBottomColor, 1.f});
 
     renderer->draw(glm::mat4(1.0f), &skyDbuff, dp);
@@ -270,7 +284,7 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
     GLuint splashTexName = 0;
     const auto fc = world->state->fadeColour;
     if ((fc.r + fc.g + fc.b) == 0 && !world->state->currentSplash.empty()) {
-        auto splashTexPtr = world->data->findSlotTexture("generic", world->state->currentSplash);
+        auto splashTexPtr = world->data->findSlotTexture("generic"_nid, NameId(world->state->currentSplash));
         if (splashTexPtr) {
             splashTexName = splashTexPtr->getName();
         }
@@ -298,10 +312,14 @@ void GameRenderer::renderObjects(const GameWorld *world) {
 
     renderer->useProgram(worldProg.get());
     RenderList renderList = createObjectRenderList(world);
+    renderListSize = renderList.size();
 
     renderer->pushDebugGroup("Objects");
     renderer->pushDebugGroup("RenderList");
-    renderer->drawBatched(renderList);
+    {
+        FrameStats::ScopedTimer timer(frameStats, FrameStats::Stage::Draw);
+        renderer->drawBatched(renderList, worldInstancedProg.get());
+    }
 
     renderer->popDebugGroup();
     profObjects = renderer->popDebugGroup();
@@ -309,9 +327,10 @@ void GameRenderer::renderObjects(const GameWorld *world) {
 
 RenderList GameRenderer::createObjectRenderList(const GameWorld *world) {
     RW_PROFILE_SCOPE(__func__);
-    // This is sequential at the moment, it should be easy to make it
-    // run in parallel with a good threading system.
-    RenderList renderList;
+    FrameStats::ScopedTimer timer(frameStats, FrameStats::Stage::RenderList);
+    // Static instances are exported in parallel when the world has a job
+    // system, everything else is sequential at the moment.
+    RenderList renderList(&renderer->getFrameArena());
     // Naive optimisation, assume 50% hitrate
     renderList.reserve(static_cast<size_t>(world->allObjects.size() * 0.5f));
 
@@ -319,9 +338,18 @@ RenderList GameRenderer::createObjectRenderList(const GameWorld *world) {
                                   (cullOverride ? cullingCamera : _camera),
                                   _renderAlpha);
 
-    // World Objects
-    for (auto object : world->allObjects) {
-        objectRenderer.buildRenderList(object, renderList);
+    // Static instances are culled hierarchically, everything else is
+    // tested object by object
+    objectRenderer.buildRenderList(world->instanceTree, renderList);
+    for (auto instance : world->instanceTree.getDynamicInstances()) {
+        objectRenderer.buildRenderList(instance, renderList);
+    }
+    for (auto pool : {&world->pedestrianPool, &world->vehiclePool,
+                      &world->pickupPool, &world->cutscenePool,
+                      &world->projectilePool}) {
+        for (auto &object : pool->objects) {
+            objectRenderer.buildRenderList(object.second.get(), renderList);
+        }
     }
 
     // Area indicators
@@ -370,9 +398,13 @@ RenderList GameRenderer::createObjectRenderList(const GameWorld *world) {
     culled += objectRenderer.culled;
 
     RW_PROFILE_SCOPE("sortRenderList");
+    FrameStats::ScopedTimer sortTimer(frameStats, FrameStats::Stage::Sort);
     // Also parallelizable
     // Earlier position in the array means earlier object's rendering
     // Transparent objects should be sorted and rendered after opaque
+    // Opaque objects are drawn front to back by coarse depth bucket so
+    // early-z can reject hidden fragments, and identical geometry in a
+    // bucket is kept together where the renderer can draw it instanced
     sort(renderList.begin(), renderList.end(),
          [](const Renderer::RenderInstruction &a,
             const Renderer::RenderInstruction &b) {
@@ -380,6 +412,16 @@ RenderList GameRenderer::createObjectRenderList(const GameWorld *world) {
                  return true;
              if (a.drawInfo.blendMode != BlendMode::BLEND_NONE && b.drawInfo.blendMode == BlendMode::BLEND_NONE)
                  return false;
+             if (a.drawInfo.blendMode == BlendMode::BLEND_NONE) {
+                 const auto bucketA = a.sortKey >> kRenderKeyBucketShift;
+                 const auto bucketB = b.sortKey >> kRenderKeyBucketShift;
+                 if (bucketA != bucketB)
+                     return bucketA < bucketB;
+                 if (a.dbuff != b.dbuff)
+                     return std::less<DrawBuffer *>()(a.dbuff, b.dbuff);
+                 if (a.drawInfo.start != b.drawInfo.start)
+                     return a.drawInfo.start < b.drawInfo.start;
+             }
              return (a.sortKey > b.sortKey);
          });
 
@@ -406,9 +448,9 @@ void GameRenderer::renderSplash(GameWorld* world, GLuint splashTexName, glm::u16
     glm::vec4 fadeNormed(fc.r / 255.f, fc.g / 255.f, fc.b / 255.f, a);
 
     renderer->useProgram(ssRectProg.get());
-    renderer->setUniform(ssRectProg.get(), "colour", fadeNormed);
-    renderer->setUniform(ssRectProg.get(), "size", glm::vec2{1.f, 1.f});
-    renderer->setUniform(ssRectProg.get(), "offset", glm::vec2{0.f, 0.f});
+    renderer->setUniform(ssRectColour, fadeNormed);
+    renderer->setUniform(ssRectSize, glm::vec2{1.f, 1.f});
+    renderer->setUniform(ssRectOffset, glm::vec2{0.f, 0.f});
 
     Renderer::DrawParameters wdp;
     wdp.depthMode = DepthMode::OFF;
@@ -437,59 +479,48 @@ void GameRenderer::renderPostProcess() {
 }
 
 void GameRenderer::renderEffects(GameWorld* world) {
-    renderer->useProgram(particleProg.get());
-
-    auto cpos = _camera.position;
-    auto cfwd = glm::normalize(glm::inverse(_camera.rotation) *
-                               glm::vec3(0.f, 1.f, 0.f));
-
-    auto& effects = world->effects;
-
-    std::sort(effects.begin(), effects.end(),
-              [&](const auto& a, const auto& b) {
-                  return glm::distance(a->position, cpos) >
-                         glm::distance(b->position, cpos);
-              });
-
-    for (auto& fx : effects) {
-        // Other effects not implemented yet
-        if (fx->getType() != Particle) continue;
-        auto particle = static_cast<ParticleFX*>(fx.get());
+    auto& particles = world->particles;
+    if (particles.size() == 0) {
+        return;
+    }
 
-        auto& p = particle->position;
+    renderer->useProgram(particleProg.get());
 
-        // Figure the direction to the camera center.
-        auto amp = cpos - p;
-        glm::vec3 ptc = particle->up;
+    particles.buildDrawOrder(_camera.position, particleKeys);
 
-        if (particle->orientation == ParticleFX::UpCamera) {
-            ptc = glm::normalize(amp - (glm::dot(amp, cfwd)) * cfwd);
-        } else if (particle->orientation == ParticleFX::Camera) {
-            ptc = amp;
+    Renderer::DrawParameters dp;
+    dp.ambient = 1.f;
+    dp.colour = glm::u8vec4(255);
+    dp.start = 0;
+    dp.count = 4;
+    dp.blendMode = BlendMode::BLEND_ADDITIVE;
+    // Additive blending doesn't depend on order, so the texture groups can
+    // be drawn one after another
+    dp.depthWrite = false;
+    dp.diffuse = 1.f;
+
+    for (auto group = particleKeys.begin(); group != particleKeys.end();) {
+        const auto texture = group->texture;
+        const auto end = std::find_if(
+            group, particleKeys.end(),
+            [texture](const auto& key) { return key.texture != texture; });
+
+        particleInstances.clear();
+        for (auto it = group; it != end; ++it) {
+            const auto i = it->particle;
+            const auto& size = particles.getSize(i);
+            particleInstances.emplace_back(
+                glm::vec4(particles.getPosition(i),
+                          static_cast<float>(particles.getOrientation(i))),
+                glm::vec4(particles.getUp(i), 0.f),
+                glm::vec4(size.x, size.y, 0.f, 0.f), particles.getColour(i));
         }
 
-        ptc = glm::normalize(ptc);
-
-        glm::mat4 transformMat(1.f);
-
-        glm::mat4 lookMat = glm::lookAt(
-            glm::vec3(0.0f,0.0f,0.0f),
-            ptc,
-            glm::vec3(0.0f,0.0f,1.0f));
-
-        transformMat = glm::scale(glm::translate(transformMat,p),
-            glm::vec3(particle->size,1.0f)) * glm::inverse(lookMat);
-
-        Renderer::DrawParameters dp;
-        dp.textures = {{particle->texture->getName()}};
-        dp.ambient = 1.f;
-        dp.colour = glm::u8vec4(particle->colour * 255.f);
-        dp.start = 0;
-        dp.count = 4;
-        dp.blendMode = BlendMode::BLEND_ADDITIVE;
-        dp.diffuse = 1.f;
-
-        renderer->drawArrays(transformMat, &particleDraw, dp);
+        dp.textures = {{texture ? texture->getName() : 0}};
+        renderer->drawArraysInstanced(particleInstances.data(),
+                                      particleInstances.size(), &particleDraw,
+                                      dp);
+        group = end;
     }
 }
 
@@ -514,9 +545,9 @@ void GameRenderer::drawRect(const glm::vec4& colour, TextureData* texture, glm::
     extents *= glm::vec4(2.f, -2.f, 1.f, 1.f);
 
     renderer->useProgram(ssRectProg.get());
-    renderer->setUniform(ssRectProg.get(), "colour", colour);
-    renderer->setUniform(ssRectProg.get(), "size", glm::vec2{extents.z, extents.w});
-    renderer->setUniform(ssRectProg.get(), "offset", glm::vec2{extents.x, extents.y});
+    renderer->setUniform(ssRectColour, colour);
+    renderer->setUniform(ssRectSize, glm::vec2{extents.z, extents.w});
+    renderer->setUniform(ssRectOffset, glm::vec2{extents.x, extents.y});
 
     Renderer::DrawParameters wdp;
     wdp.depthMode = DepthMode::OFF;
@@ -530,9 +561,9 @@ void GameRenderer::drawRect(const glm::vec4& colour, TextureData* texture, glm::
 void GameRenderer::renderLetterbox() {
     constexpr float cinematicExperienceSize = 0.15f;
     renderer->useProgram(ssRectProg.get());
-    renderer->setUniform(ssRectProg.get(), "colour", glm::vec4{0.f, 0.f, 0.f, 1.f});
-    renderer->setUniform(ssRectProg.get(), "size", glm::vec2{1.f, cinematicExperienceSize});
-    renderer->setUniform(ssRectProg.get(), "offset", glm::vec2{0.f,-1.f * (1.f - cinematicExperienceSize)});
+    renderer->setUniform(ssRectColour, glm::vec4{0.f, 0.f, 0.f, 1.f});
+    renderer->setUniform(ssRectSize, glm::vec2{1.f, cinematicExperienceSize});
+    renderer->setUniform(ssRectOffset, glm::vec2{0.f,-1.f * (1.f - cinematicExperienceSize)});
     Renderer::DrawParameters wdp;
     wdp.depthMode = DepthMode::OFF;
     wdp.blendMode = BlendMode::BLEND_NONE;
@@ -540,7 +571,7 @@ void GameRenderer::renderLetterbox() {
     wdp.textures = {{0}};
 
     renderer->drawArrays(glm::mat4(1.0f), &ssRectDraw, wdp);
-    renderer->setUniform(ssRectProg.get(), "offset", glm::vec2{0.f, 1.f * (1.f - cinematicExperienceSize)});
+    renderer->setUniform(ssRectOffset, glm::vec2{0.f, 1.f * (1.f - cinematicExperienceSize)});
     renderer->drawArrays(glm::mat4(1.0f), &ssRectDraw, wdp);
 }
 
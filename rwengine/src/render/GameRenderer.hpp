@@ -3,14 +3,18 @@
 
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 #include <gl/DrawBuffer.hpp>
 #include <gl/GeometryBuffer.hpp>
 
 #include <rw/forward.hpp>
 
+#include <core/FrameStats.hpp>
+
 #include <render/OpenGLRenderer.hpp>
 #include <render/MapRenderer.hpp>
+#include <render/ParticleSystem.hpp>
 #include <render/TextRenderer.hpp>
 #include <render/ViewCamera.hpp>
 #include <render/WaterRenderer.hpp>
@@ -51,6 +55,9 @@ class GameRenderer {
     /** Number of culling events */
     size_t culled;
 
+    /** Number of instructions in the last object render list */
+    size_t renderListSize = 0;
+
     GLuint framebufferName;
     GLuint fbTextures[2];
     GLuint fbRenderBuffers[1];
@@ -58,15 +65,26 @@ class GameRenderer {
 
     GeometryBuffer particleGeom;
     DrawBuffer particleDraw;
+    /// Reused between frames by renderEffects
+    std::vector<ParticleSystem::DrawKey> particleKeys;
+    std::vector<glm::mat4> particleInstances;
 
     GeometryBuffer ssRectGeom;
     DrawBuffer ssRectDraw;
 
+    Renderer::UniformHandle<glm::vec4> skyTopColour;
+    Renderer::UniformHandle<glm::vec4> skyBottomColour;
+
+    Renderer::UniformHandle<glm::vec4> ssRectColour;
+    Renderer::UniformHandle<glm::vec2> ssRectSize;
+    Renderer::UniformHandle<glm::vec2> ssRectOffset;
+
 public:
     GameRenderer(Logger* log, GameData* data);
     ~GameRenderer();
 
     std::unique_ptr<Renderer::ShaderProgram> worldProg;
+    std::unique_ptr<Renderer::ShaderProgram> worldInstancedProg;
     std::unique_ptr<Renderer::ShaderProgram> skyProg;
     std::unique_ptr<Renderer::ShaderProgram> particleProg;
 
@@ -85,6 +103,15 @@ public:
         return culled;
     }
 
+    size_t getRenderListSize() const {
+        return renderListSize;
+    }
+
+    /**
+     * Stage timings are added to these stats, if set
+     */
+    FrameStats* frameStats = nullptr;
+
     /**
      * Renders the world using the parameters of the passed Camera.
      * Note: The camera's near and far planes are overriden by weather effects.
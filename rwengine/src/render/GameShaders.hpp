@@ -242,13 +242,113 @@ struct WorldObject {
             })";
 };
 
-/** @brief Particle effect shaders, uses WorldObject::VertexShader */
+/**
+ * @brief Instanced variant of WorldObject, uses WorldObject::FragmentShader
+ *
+ * The model matrix is read from a per-instance attribute instead of the
+ * ObjectData block, the rest of ObjectData is shared by every instance.
+ */
+struct WorldObjectInstanced {
+    static constexpr char const* VertexShader =
+        R"(
+            #version 330
+
+            layout(location = 0) in vec3 position;
+            layout(location = 1) in vec3 normal;
+            layout(location = 2) in vec4 _colour;
+            layout(location = 3) in vec2 texCoords;
+            layout(location = 4) in mat4 instanceModel;
+            out vec3 Normal;
+            out vec2 TexCoords;
+            out vec4 Colour;
+            out vec4 WorldSpace;
+
+            layout(std140) uniform SceneData {
+                mat4 projection;
+                mat4 view;
+                vec4 ambient;
+                vec4 dynamic;
+                vec4 fogColor;
+                vec4 campos;
+                float fogStart;
+                float fogEnd;
+            };
+
+            void main() {
+                Normal = normal;
+                TexCoords = texCoords;
+                Colour = _colour;
+                vec4 worldspace = instanceModel * vec4(position, 1.0);
+                vec4 viewspace = view * worldspace;
+                gl_Position = projection * viewspace;
+
+                WorldSpace = vec4(worldspace.xyz, length(worldspace.xyz - campos.xyz));
+            })";
+};
+
+/**
+ * @brief Instanced particle shaders
+ *
+ * Each instance is a particle packed into the instance matrix by
+ * GameRenderer::renderEffects: the centre and orientation mode, the up
+ * vector, the size and the colour. The quad is turned to face the camera
+ * here.
+ */
 struct Particle {
+    static constexpr char const* VertexShader =
+        R"(
+            #version 330
+
+            layout(location = 0) in vec2 position;
+            layout(location = 3) in vec2 texCoords;
+            layout(location = 4) in mat4 particle;
+            out vec2 TexCoords;
+            out vec4 Colour;
+
+            layout(std140) uniform SceneData {
+                mat4 projection;
+                mat4 view;
+                vec4 ambient;
+                vec4 dynamic;
+                vec4 fogColor;
+                vec4 campos;
+                float fogStart;
+                float fogEnd;
+            };
+
+            const vec3 worldUp = vec3(0.0, 0.0, 1.0);
+
+            void main() {
+                vec3 centre = particle[0].xyz;
+                int orientation = int(particle[0].w);
+                vec3 toCamera = campos.xyz - centre;
+
+                // Free particles face along their up vector
+                vec3 facing = particle[1].xyz;
+                if (orientation == 1) {
+                    facing = toCamera;
+                } else if (orientation == 2) {
+                    vec3 forward = -vec3(view[0][2], view[1][2], view[2][2]);
+                    facing = toCamera - dot(toCamera, forward) * forward;
+                }
+                facing = normalize(facing);
+
+                vec3 right = cross(facing, worldUp);
+                right = dot(right, right) > 0.0 ? normalize(right)
+                                                 : vec3(1.0, 0.0, 0.0);
+                vec3 up = cross(right, facing);
+
+                vec2 offset = position * particle[2].xy;
+                vec3 worldspace = centre + right * offset.x + up * offset.y;
+
+                TexCoords = texCoords;
+                Colour = particle[3];
+                gl_Position = projection * view * vec4(worldspace, 1.0);
+            })";
     static constexpr char const* FragmentShader =
         R"(
             #version 330
 
-            in vec3 Normal;
             in vec2 TexCoords;
             in vec4 Colour;
             uniform sampler2D tex;
@@ -281,7 +381,7 @@ struct Particle {
                 if(c.a <= ALPHA_DISCARD_THRESHOLD) discard;
                 float fogZ = (gl_FragCoord.z / gl_FragCoord.w);
                 float fogfac = clamp( (fogStart-fogZ)/(fogEnd-fogStart), 0.0, 1.0 );
-                vec4 tint = vec4(colour.rgb, visibility);
+                vec4 tint = vec4(Colour.rgb * colour.rgb, visibility);
                 outColour = c * tint;
             })";
 };
@@ -1,7 +1,9 @@
 #include "render/MapRenderer.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <cmath>
+#include <utility>
 #include <vector>
 
 #include <glm/glm.hpp>
@@ -9,6 +11,7 @@
 #include <glm/gtc/quaternion.hpp>
 
 #include <gl/gl_core_3_3.h>
+#include <gl/StreamBuffer.hpp>
 #include <gl/TextureData.hpp>
 
 #include "engine/GameData.hpp"
@@ -45,6 +48,108 @@ void main() {
     vec4 c = texture(spriteTexture, TexCoord*0.99);
     outColour = vec4(colour.rgb + c.rgb, colour.a * c.a);
 })";
+
+constexpr char const* AtlasVertexShader = R"(
+#version 330
+
+layout(location = 0) in vec2 position;
+layout(location = 2) in vec4 colour;
+layout(location = 3) in vec3 texcoord;
+out vec3 TexCoord;
+out vec4 Colour;
+
+uniform mat4 proj;
+uniform mat4 view;
+
+void main() {
+    gl_Position = proj * view * vec4(position, 0.0, 1.0);
+    TexCoord = texcoord;
+    Colour = colour;
+})";
+
+constexpr char const* AtlasFragmentShader = R"(
+#version 330
+
+in vec3 TexCoord;
+in vec4 Colour;
+uniform sampler2DArray atlas;
+out vec4 outColour;
+
+void main() {
+    vec4 c = TexCoord.z < 0.0 ? vec4(0.0, 0.0, 0.0, 1.0)
+                              : texture(atlas, TexCoord);
+    outColour = vec4(Colour.rgb + c.rgb, Colour.a * c.a);
+})";
+
+constexpr int kMapBlockLine = 8;
+
+// Corners of a unit quad as two triangles
+constexpr float kQuadCorners[6][2] = {{-.5f, -.5f}, {.5f, -.5f}, {.5f, .5f},
+                                      {-.5f, -.5f}, {.5f, .5f},  {-.5f, .5f}};
+
+/**
+ * Copies the textures into the layers of a new texture array, the layers
+ * are the size of the largest texture. Smaller textures occupy the top left
+ * of their layer, with their last column and row repeated over the rest so
+ * that filtering at their edges doesn't pick up anything else. The layers
+ * of missing textures are transparent.
+ */
+GLuint createTextureArray(const std::vector<TextureData*>& textures,
+                          const glm::ivec2& size) {
+    GLuint array;
+    glGenTextures(1, &array);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, array);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, size.x, size.y,
+                 static_cast<GLsizei>(textures.size()), 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, nullptr);
+
+    // Read back once, compressed textures are decompressed by the driver
+    std::vector<uint32_t> pixels;
+    std::vector<uint32_t> layerPixels(static_cast<size_t>(size.x) * size.y);
+    for (size_t layer = 0; layer < textures.size(); ++layer) {
+        const auto texture = textures[layer];
+        if (texture) {
+            const auto& textureSize = texture->getSize();
+            pixels.resize(static_cast<size_t>(textureSize.x) * textureSize.y);
+            glBindTexture(GL_TEXTURE_2D, texture->getName());
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                          pixels.data());
+
+            for (auto y = 0; y < size.y; ++y) {
+                const auto row = std::min(y, textureSize.y - 1) * textureSize.x;
+                for (auto x = 0; x < size.x; ++x) {
+                    layerPixels[static_cast<size_t>(y * size.x + x)] =
+                        pixels[static_cast<size_t>(
+                            row + std::min(x, textureSize.x - 1))];
+                }
+            }
+        } else {
+            std::fill(layerPixels.begin(), layerPixels.end(), 0u);
+        }
+
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0,
+                        static_cast<GLint>(layer), size.x, size.y, 1, GL_RGBA,
+                        GL_UNSIGNED_BYTE, layerPixels.data());
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    return array;
+}
+
+glm::ivec2 largestSize(const std::vector<TextureData*>& textures) {
+    glm::ivec2 size{0, 0};
+    for (auto texture : textures) {
+        if (texture) {
+            size = glm::max(size, texture->getSize());
+        }
+    }
+    return size;
+}
 }  // namespace
 
 MapRenderer::MapRenderer(Renderer &renderer, GameData* _data)
@@ -66,13 +171,132 @@ MapRenderer::MapRenderer(Renderer &renderer, GameData* _data)
     circle.setFaceType(GL_TRIANGLE_FAN);
 
     rectProg = renderer.createShader(MapVertexShader, MapFragmentShader);
+    rectProj = renderer.getUniform<glm::mat4>(rectProg.get(), "proj");
+    rectView = renderer.getUniform<glm::mat4>(rectProg.get(), "view");
+    rectModel = renderer.getUniform<glm::mat4>(rectProg.get(), "model");
+    rectColour = renderer.getUniform<glm::vec4>(rectProg.get(), "colour");
+
+    renderer.setUniform(rectColour, glm::vec4(1.f));
 
-    renderer.setUniform(rectProg.get(), "colour", glm::vec4(1.f));
+    atlasProg = renderer.createShader(AtlasVertexShader, AtlasFragmentShader);
+    atlasProj = renderer.getUniform<glm::mat4>(atlasProg.get(), "proj");
+    atlasView = renderer.getUniform<glm::mat4>(atlasProg.get(), "view");
+    renderer.setUniformTexture(atlasProg.get(), "atlas", 0);
+
+    renderer.getStreamBuffer().bind(blips, MapVertex::vertex_attributes());
+}
+
+MapRenderer::~MapRenderer() {
+    glDeleteTextures(1, &tileTextures);
+    glDeleteTextures(1, &spriteTextures);
 }
 
 #define GAME_MAP_SIZE 4000
 
+void MapRenderer::buildAtlas() {
+    if (atlasBuilt) {
+        return;
+    }
+
+    // radar00 = -x, +y
+    // incrementing in X, then Y
+    std::vector<TextureData*> tileTextureList(MAP_BLOCK_SIZE);
+    size_t textureCount = 0;
+    bool complete = true;
+    for (int m = 0; m < MAP_BLOCK_SIZE; ++m) {
+        std::string num = (m < 10 ? "0" : "");
+        std::string name = "radar" + num + std::to_string(m);
+        const auto id = NameId::intern(name);
+        tileTextureList[m] = data->findSlotTexture(id, id);
+        if (tileTextureList[m]) {
+            textureCount++;
+        } else {
+            complete = false;
+        }
+    }
+
+    // Every sprite a blip can use
+    std::vector<std::pair<NameId, TextureData*>> spriteList;
+    auto hud = data->textureSlots.find("hud"_nid);
+    if (hud != data->textureSlots.end()) {
+        for (const auto& [name, texture] : hud->second) {
+            if (name.str().compare(0, 6, "radar_") == 0) {
+                spriteList.emplace_back(name, texture.get());
+            }
+        }
+    } else {
+        complete = false;
+    }
+    textureCount += spriteList.size();
+
+    // Until everything is loaded the atlas is rebuilt whenever more
+    // textures are available
+    if (textureCount == atlasTextureCount) {
+        return;
+    }
+    atlasTextureCount = textureCount;
+    atlasBuilt = complete;
+
+    glDeleteTextures(1, &tileTextures);
+    glDeleteTextures(1, &spriteTextures);
+    tileTextures = spriteTextures = 0;
+    sprites.clear();
+
+    const auto tileLayerSize = largestSize(tileTextureList);
+    std::vector<MapVertex> tileVertices;
+    if (tileLayerSize.x > 0) {
+        tileTextures = createTextureArray(tileTextureList, tileLayerSize);
+
+        const glm::vec2 tileSize =
+            glm::vec2(GAME_MAP_SIZE) / static_cast<float>(kMapBlockLine);
+        const int initX = -(kMapBlockLine / 2);
+        const int initY = -(kMapBlockLine / 2);
+        for (int m = 0; m < MAP_BLOCK_SIZE; ++m) {
+            const auto texture = tileTextureList[m];
+            if (!texture) {
+                continue;
+            }
+
+            int mX = initX + (m % kMapBlockLine);
+            int mY = initY + (m / kMapBlockLine);
+            auto tc = glm::vec2(mX, mY) * tileSize + glm::vec2(tileSize / 2.f);
+            const auto scale =
+                glm::vec2(texture->getSize()) / glm::vec2(tileLayerSize);
+
+            for (const auto& corner : kQuadCorners) {
+                const glm::vec2 c(corner[0], corner[1]);
+                tileVertices.push_back(
+                    {tc + c * tileSize,
+                     glm::vec3((c + glm::vec2(0.5f)) * scale,
+                               static_cast<float>(m)),
+                     glm::vec4(0.f, 0.f, 0.f, 1.f)});
+            }
+        }
+    }
+    tileGeom.uploadVertices(tileVertices);
+    tiles.addGeometry(&tileGeom);
+    tiles.setFaceType(GL_TRIANGLES);
+
+    std::vector<TextureData*> spriteTextureList;
+    spriteTextureList.reserve(spriteList.size());
+    for (const auto& [name, texture] : spriteList) {
+        sprites[name] = {static_cast<float>(spriteTextureList.size()),
+                         glm::vec2(texture->getSize())};
+        spriteTextureList.push_back(texture);
+    }
+
+    const auto spriteLayerSize = largestSize(spriteTextureList);
+    if (spriteLayerSize.x > 0) {
+        spriteTextures = createTextureArray(spriteTextureList, spriteLayerSize);
+        for (auto& sprite : sprites) {
+            sprite.second.texcoordScale /= glm::vec2(spriteLayerSize);
+        }
+    }
+}
+
 void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
+    buildAtlas();
+
     renderer.pushDebugGroup("Map");
     renderer.useProgram(rectProg.get());
 
@@ -81,24 +305,20 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
     dp.blendMode = BlendMode::BLEND_ALPHA;
     dp.depthWrite = false;
 
-    // World out the number of units per tile
-    glm::vec2 worldSize(GAME_MAP_SIZE);
-    const int mapBlockLine = 8;
-    glm::vec2 tileSize = worldSize / static_cast<float>(mapBlockLine);
     // Determine the scale to show the right number of world units on the screen
     float worldScale = mi.screenSize / mi.worldSize;
 
     auto proj = renderer.get2DProjection();
     glm::mat4 view{1.0f}, model{1.0f};
-    renderer.setUniform(rectProg.get(), "proj", proj);
-    renderer.setUniform(rectProg.get(), "model", glm::mat4(1.0f));
-    renderer.setUniform(rectProg.get(), "colour", glm::vec4(0.f, 0.f, 0.f, 1.f));
+    renderer.setUniform(rectProj, proj);
+    renderer.setUniform(rectModel, glm::mat4(1.0f));
+    renderer.setUniform(rectColour, glm::vec4(0.f, 0.f, 0.f, 1.f));
 
     view = glm::translate(view, glm::vec3(mi.screenPosition, 0.f));
 
     if (mi.clipToSize) {
         glm::mat4 circleView = glm::scale(view, glm::vec3(mi.screenSize));
-        renderer.setUniform(rectProg.get(), "view", circleView);
+        renderer.setUniform(rectView, circleView);
         dp.count = 182;
         glEnable(GL_STENCIL_TEST);
         glStencilFunc(GL_ALWAYS, 1, 0xFF);
@@ -114,66 +334,54 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
     view = glm::rotate(view, mi.rotation, glm::vec3(0.f, 0.f, 1.f));
     view = glm::translate(
         view, glm::vec3(glm::vec2(-1.f, 1.f) * mi.worldCenter, 0.f));
-    renderer.setUniform(rectProg.get(), "view", view);
-
-    // radar00 = -x, +y
-    // incrementing in X, then Y
-
-    int initX = -(mapBlockLine / 2);
-    int initY = -(mapBlockLine / 2);
-
-    for (int m = 0; m < MAP_BLOCK_SIZE; ++m) {
-        std::string num = (m < 10 ? "0" : "");
-        std::string name = "radar" + num + std::to_string(m);
-        auto texturePtr = world->data->findSlotTexture(name, name);
-        dp.textures = {{texturePtr->getName()}};
-
-        dp.count = 4;
-
-        int mX = initX + (m % mapBlockLine);
-        int mY = initY + (m / mapBlockLine);
-
-        auto tc = glm::vec2(mX, mY) * tileSize + glm::vec2(tileSize / 2.f);
-
-        glm::mat4 tilemodel = model;
-        tilemodel = glm::translate(tilemodel, glm::vec3(tc, 0.f));
-        tilemodel = glm::scale(tilemodel, glm::vec3(tileSize, 1.f));
-
-        renderer.setUniform(rectProg.get(), "model", tilemodel);
 
-        renderer.drawArrays(glm::mat4(1.0f), &rect, dp);
+    // Every tile in one draw
+    renderer.useProgram(atlasProg.get());
+    renderer.setUniform(atlasProj, proj);
+    renderer.setUniform(atlasView, view);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, tileTextures);
+    dp.count = static_cast<size_t>(tileGeom.getCount());
+    if (dp.count > 0) {
+        renderer.drawArrays(glm::mat4(1.0f), &tiles, dp);
     }
 
+    renderer.useProgram(rectProg.get());
+
     // From here on out we will work in screenspace
-    renderer.setUniform(rectProg.get(), "view", glm::mat4(1.0f));
+    renderer.setUniform(rectView, glm::mat4(1.0f));
 
     if (mi.clipToSize) {
         glDisable(GL_STENCIL_TEST);
         // We only need the outer ring if we're clipping.
         glBlendFuncSeparate(GL_DST_COLOR, GL_ZERO, GL_ONE, GL_ZERO);
-        auto radarDiscTexPtr = data->findSlotTexture("hud", "radardisc");
+        auto radarDiscTexPtr =
+            data->findSlotTexture("hud"_nid, "radardisc"_nid);
         dp.textures = {{radarDiscTexPtr->getName()}};
 
         glm::mat4 model{1.0f};
         model = glm::translate(model, glm::vec3(mi.screenPosition, 0.0f));
         model = glm::scale(model, glm::vec3(mi.screenSize * 1.07f));
-        renderer.setUniform(rectProg.get(), "model", model);
+        renderer.setUniform(rectModel, model);
         renderer.drawArrays(glm::mat4(1.0f), &rect, dp);
         glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
                             GL_ZERO);
     }
 
+    blipVertices.clear();
+    outlineVertices.clear();
+
     // Draw the player blip
     auto player = world->pedestrianPool.find(world->state->playerObject);
     if (player) {
         glm::vec2 plyblip(player->getPosition());
         float hdg = glm::roll(player->getRotation());
-        drawBlip(plyblip, view, mi, "radar_centre",
+        addBlip(plyblip, view, mi, "radar_centre"_nid,
                  glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), defaultBlipSize, mi.rotation - hdg);
     }
 
-    drawBlip(mi.worldCenter + glm::vec2(0.f, mi.worldSize), view, mi,
-             "radar_north", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), radarNorthBlipSize);
+    addBlip(mi.worldCenter + glm::vec2(0.f, mi.worldSize), view, mi,
+             "radar_north"_nid, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), radarNorthBlipSize);
 
     for (auto& radarBlip : world->state->radarBlips) {
         const auto& blip = radarBlip.second;
@@ -193,7 +401,7 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
 
         const auto& texture = blip.texture;
         if (!texture.empty()) {
-            drawBlip(blippos, view, mi, texture,
+            addBlip(blippos, view, mi, NameId(texture),
                      glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), defaultBlipSize);
         } else {
             // Colours from http://www.gtamodding.com/wiki/0165 (colors not
@@ -232,18 +440,56 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
                              1.0f  // Note: Alpha is not controlled by blip
                              );
 
-            drawBlip(blippos, view, mi, colour, blip.size * hudScale * 2.0f);
+            addBlip(blippos, view, mi, colour, blip.size * hudScale * 2.0f);
+        }
+    }
+
+    // The blips in one draw, then their outlines on top
+    const auto blipCount = blipVertices.size();
+    const auto outlineCount = outlineVertices.size();
+    if (blipCount > 0) {
+        blipVertices.insert(blipVertices.end(), outlineVertices.begin(),
+                            outlineVertices.end());
+        const auto allocation = renderer.getStreamBuffer().upload(
+            blipVertices.data(), blipVertices.size());
+
+        renderer.useProgram(atlasProg.get());
+        renderer.setUniform(atlasView, glm::mat4(1.0f));
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, spriteTextures);
+
+        dp.textures = {};
+        dp.start = allocation.baseVertex;
+        dp.count = blipCount;
+        blips.setFaceType(GL_TRIANGLES);
+        renderer.drawArrays(glm::mat4(1.0f), &blips, dp);
+
+        if (outlineCount > 0) {
+            dp.start = allocation.baseVertex + blipCount;
+            dp.count = outlineCount;
+            blips.setFaceType(GL_LINES);
+            renderer.drawArrays(glm::mat4(1.0f), &blips, dp);
         }
     }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 
     /// @TODO migrate to using the renderer
     renderer.invalidate();
     renderer.popDebugGroup();
 }
 
-void MapRenderer::prepareBlip(const glm::vec2& coord, const glm::mat4& view,
-                              const MapInfo& mi, const std::string& texture,
-                              glm::vec4 colour, float size, float heading) {
+void MapRenderer::addBlip(const glm::vec2& coord, const glm::mat4& view,
+                          const MapInfo& mi, NameId texture,
+                          glm::vec4 colour, float size, float heading) {
+    Sprite sprite{-1.f, glm::vec2(1.f)};
+    if (texture != NameId()) {
+        auto it = sprites.find(texture);
+        if (it == sprites.end()) {
+            return;
+        }
+        sprite = it->second;
+    }
+
     glm::vec2 adjustedCoord = coord;
     if (mi.clipToSize) {
         float maxDist = mi.worldSize / 2.f;
@@ -254,40 +500,38 @@ void MapRenderer::prepareBlip(const glm::vec2& coord, const glm::mat4& view,
         }
     }
 
-    glm::vec3 viewPos(
+    glm::vec2 viewPos(
         view * glm::vec4(glm::vec2(1.f, -1.f) * adjustedCoord, 0.f, 1.f));
-    glm::mat4 model{1.0f};
-    model = glm::translate(model, viewPos);
-    model = glm::scale(model, glm::vec3(size));
-    model = glm::rotate(model, heading, glm::vec3(0.f, 0.f, 1.f));
-    renderer.setUniform(rectProg.get(), "model", model);
-
-    GLuint tex = 0;
-    if (!texture.empty()) {
-        auto spriteTexPtr = data->findSlotTexture("hud", texture);
-        tex = spriteTexPtr->getName();
+    const float s = std::sin(heading);
+    const float c = std::cos(heading);
+    auto place = [&](const float corner[2]) {
+        const glm::vec2 p = glm::vec2(corner[0], corner[1]) * size;
+        return viewPos + glm::vec2(p.x * c - p.y * s, p.x * s + p.y * c);
+    };
+
+    for (const auto& corner : kQuadCorners) {
+        blipVertices.push_back(
+            {place(corner),
+             glm::vec3((glm::vec2(corner[0], corner[1]) + glm::vec2(0.5f)) *
+                           sprite.texcoordScale,
+                       sprite.layer),
+             colour});
     }
-    renderer.setUniform(rectProg.get(), "colour", colour);
-
-    glBindTexture(GL_TEXTURE_2D, tex);
-
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-}
-
-void MapRenderer::drawBlip(const glm::vec2& coord, const glm::mat4& view,
-                           const MapInfo& mi, const std::string& texture,
-                           glm::vec4 colour, float size, float heading) {
-    prepareBlip(coord, view, mi, texture, colour, size, heading);
-    glBindVertexArray(rect.getVAOName());
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 }
 
-void MapRenderer::drawBlip(const glm::vec2& coord, const glm::mat4& view,
-                           const MapInfo& mi, glm::vec4 colour, float size) {
-    drawBlip(coord, view, mi, "", colour, size);
-    // Draw outline
-    renderer.setUniform(rectProg.get(), "colour", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
-    glDrawArrays(GL_LINE_LOOP, 0, 4);
+void MapRenderer::addBlip(const glm::vec2& coord, const glm::mat4& view,
+                          const MapInfo& mi, glm::vec4 colour, float size) {
+    addBlip(coord, view, mi, NameId(), colour, size);
+
+    // Outline the quad just added
+    const auto quad = blipVertices.end() - 6;
+    const MapVertex* loop[4] = {&quad[0], &quad[1], &quad[2], &quad[5]};
+    for (int i = 0; i < 4; ++i) {
+        for (auto v : {loop[i], loop[(i + 1) % 4]}) {
+            outlineVertices.push_back({v->position, glm::vec3(0.f, 0.f, -1.f),
+                                       glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)});
+        }
+    }
 }
 
 void MapRenderer::scaleHUD(const float scale) {
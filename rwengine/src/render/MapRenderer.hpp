@@ -3,9 +3,12 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <gl/DrawBuffer.hpp>
 #include <gl/GeometryBuffer.hpp>
+#include <rw/StringId.hpp>
 
 #include "render/OpenGLRenderer.hpp"
 
@@ -16,6 +19,10 @@ class GameWorld;
 
 /**
  * Utility class for rendering the world map, in the menu and radar.
+ *
+ * The radar tiles and blip sprites are copied into two texture arrays by
+ * buildAtlas, so the tiles are drawn with a single draw from a static
+ * buffer and the blips of a frame are collected and drawn together.
  */
 class MapRenderer {
 public:
@@ -35,6 +42,14 @@ public:
     };
 
     MapRenderer(Renderer& renderer, GameData* data);
+    ~MapRenderer();
+
+    /**
+     * Copies the radar tiles and blip sprites into texture arrays. Called
+     * before every draw, the arrays are rebuilt while some of the textures
+     * are still missing and more have been loaded since the last call.
+     */
+    void buildAtlas();
 
     void draw(GameWorld* world, const MapInfo& mi);
     void scaleHUD(const float scale);
@@ -54,15 +69,59 @@ private:
     float hudScale = 1.f;
 
     std::unique_ptr<Renderer::ShaderProgram> rectProg;
+    Renderer::UniformHandle<glm::mat4> rectProj;
+    Renderer::UniformHandle<glm::mat4> rectView;
+    Renderer::UniformHandle<glm::mat4> rectModel;
+    Renderer::UniformHandle<glm::vec4> rectColour;
+
+    std::unique_ptr<Renderer::ShaderProgram> atlasProg;
+    Renderer::UniformHandle<glm::mat4> atlasProj;
+    Renderer::UniformHandle<glm::mat4> atlasView;
+
+    struct MapVertex {
+        glm::vec2 position;
+        /// Texture coordinate and array layer, negative if untextured
+        glm::vec3 texcoord;
+        glm::vec4 colour;
+
+        static const AttributeList vertex_attributes() {
+            return {
+                {ATRS_Position, 2, sizeof(MapVertex), 0ul},
+                {ATRS_TexCoord, 3, sizeof(MapVertex), sizeof(glm::vec2)},
+                {ATRS_Colour, 4, sizeof(MapVertex),
+                 sizeof(glm::vec2) + sizeof(glm::vec3)},
+            };
+        }
+    };
+
+    /// Where a sprite lives in the sprite array
+    struct Sprite {
+        float layer;
+        /// The sprite occupies the top left of its layer
+        glm::vec2 texcoordScale;
+    };
 
-    void prepareBlip(const glm::vec2& coord, const glm::mat4& view,
-                     const MapInfo& mi, const std::string& texture,
-                     glm::vec4 colour, float size, float heading);
-    void drawBlip(const glm::vec2& coord, const glm::mat4& view,
-                  const MapInfo& mi, const std::string& texture,
-                  glm::vec4 colour, float size, float heading = 0.0f);
-    void drawBlip(const glm::vec2& coord, const glm::mat4& view,
-                  const MapInfo& mi, glm::vec4 colour, float size);
+    /// Set once every texture has been copied into the arrays
+    bool atlasBuilt = false;
+    /// Textures found by the last buildAtlas
+    size_t atlasTextureCount = 0;
+    GLuint tileTextures = 0;
+    GLuint spriteTextures = 0;
+    std::unordered_map<NameId, Sprite> sprites;
+
+    /// Every tile in world space
+    GeometryBuffer tileGeom;
+    DrawBuffer tiles;
+
+    /// Rebuilt every draw and streamed, the outlines follow the blips
+    std::vector<MapVertex> blipVertices;
+    std::vector<MapVertex> outlineVertices;
+    DrawBuffer blips;
+
+    void addBlip(const glm::vec2& coord, const glm::mat4& view,
+                 const MapInfo& mi, NameId texture, glm::vec4 colour, float size, float heading = 0.0f);
+    void addBlip(const glm::vec2& coord, const glm::mat4& view,
+                 const MapInfo& mi, glm::vec4 colour, float size);
 };
 
 #endif
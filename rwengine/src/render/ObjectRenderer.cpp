@@ -1,12 +1,17 @@
 #include "render/ObjectRenderer.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <iterator>
+#include <memory_resource>
 
 #include <BulletDynamics/Vehicle/btRaycastVehicle.h>
 #include <glm/gtc/type_ptr.hpp>
 
 #include <data/Clump.hpp>
 
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
 #include "data/CutsceneData.hpp"
 #include "data/WeaponData.hpp"
 #include "engine/GameData.hpp"
@@ -34,15 +39,26 @@ constexpr float kPedestrianDrawDistanceFactor = kDrawDistanceFactor;
 constexpr float kMagicLODDistance = 330.f;
 constexpr float kVehicleLODDistance = 70.f;
 constexpr float kVehicleDrawDistance = 280.f;
+// Static instances per job when building the render list in parallel
+constexpr size_t kInstanceGrainSize = 256;
 
 RenderKey createKey(float normalizedDepth, Renderer::Textures& textures) {
-    return (uint32_t(0x7FFFFF * normalizedDepth) << 8 |
-            uint8_t(0xFF & (!textures.empty() ? textures[0] : 0)));
+    const auto depth = glm::clamp(normalizedDepth, 0.f, 1.f);
+    const auto bucket =
+        std::min(static_cast<RenderKey>(depth * kRenderKeyBucketCount),
+                 static_cast<RenderKey>(kRenderKeyBucketCount - 1));
+    return bucket << kRenderKeyBucketShift |
+           RenderKey(uint32_t(0x7FFFFF * depth * depth) << 8) |
+           uint8_t(0xFF & (!textures.empty() ? textures[0] : 0));
 }
 
 void ObjectRenderer::renderGeometry(Geometry* geom,
                                     const glm::mat4& modelMatrix,
                                     GameObject* object, RenderList& outList) {
+    const glm::mat4 vertexMatrix = geom->quantizedPositions
+                                       ? modelMatrix * geom->positionTransform
+                                       : modelMatrix;
+
     for (SubGeometry& subgeom : geom->subgeom) {
         bool isTransparent = false;
 
@@ -50,7 +66,8 @@ void ObjectRenderer::renderGeometry(Geometry* geom,
 
         dp.colour = {255, 255, 255, 255};
         dp.count = subgeom.numIndices;
-        dp.start = subgeom.start;
+        dp.start = geom->getFirstIndex() + subgeom.start;
+        dp.baseVertex = geom->getBaseVertex();
         dp.textures = {{0}};
         dp.visibility = 1.f;
 
@@ -105,8 +122,8 @@ void ObjectRenderer::renderGeometry(Geometry* geom,
         float distance = glm::length(m_camera.position - position);
         float depth = (distance - m_camera.frustum.near) /
                       (m_camera.frustum.far - m_camera.frustum.near);
-        outList.emplace_back(createKey(depth * depth, dp.textures), modelMatrix,
-                             &geom->dbuff, dp);
+        outList.emplace_back(createKey(depth, dp.textures),
+                             vertexMatrix, geom->getDrawBuffer(), dp);
     }
 }
 
@@ -134,13 +151,38 @@ void ObjectRenderer::renderAtomic(Atomic* atomic,
 
 void ObjectRenderer::renderClump(Clump* model, const glm::mat4& worldtransform,
                                  GameObject* object, RenderList& render) {
+    // Test all of the atomic bounds against the frustum at once
+    clumpSpheres.clear();
+    clumpTransforms.clear();
     for (const auto& atomic : model->getAtomics()) {
         const auto flags = atomic->getFlags();
         if ((flags & Atomic::ATOMIC_RENDER) == 0) {
             continue;
         }
+        const auto& geometry = atomic->getGeometry();
+        const auto& frame = atomic->getFrame();
+        RW_CHECK(geometry, "Can't render an atomic without geometry");
+        RW_CHECK(frame, "Can't render an atomic without a frame");
+        if (!geometry || !frame) {
+            continue;
+        }
+
+        const auto& bounds = geometry->geometryBounds;
+        auto transform = worldtransform * frame->getWorldTransform();
+        clumpSpheres.add(bounds.center + glm::vec3(transform[3]),
+                         bounds.radius);
+        clumpTransforms.emplace_back(atomic.get(), transform);
+    }
 
-        renderAtomic(atomic.get(), worldtransform, object, render);
+    m_camera.frustum.intersects(clumpSpheres);
+
+    for (auto i = 0u; i < clumpTransforms.size(); ++i) {
+        if (!clumpSpheres.isVisible(i)) {
+            culled++;
+            continue;
+        }
+        const auto& [atomic, transform] = clumpTransforms[i];
+        renderGeometry(atomic->getGeometry().get(), transform, object, render);
     }
 }
 
@@ -234,7 +276,7 @@ void ObjectRenderer::renderCharacter(CharacterObject* pedestrian,
         return;  // No model for this item
     }
 
-    auto handFrame = pedestrian->getClump()->findFrame("srhand");
+    auto handFrame = pedestrian->getClump()->findFrame("srhand"_nid);
     if (handFrame) {
         auto simple =
             m_world->data->findModelInfo<SimpleModelInfo>(weapon.modelID);
@@ -337,6 +379,52 @@ void ObjectRenderer::renderProjectile(ProjectileObject* projectile,
     renderAtomic(atomic.get(), glm::mat4(1.0f), nullptr, outList);
 }
 
+void ObjectRenderer::buildRenderList(const InstanceTree& tree,
+                                     RenderList& outList) {
+    std::pmr::vector<InstanceObject*> visible(
+        outList.get_allocator().resource());
+    tree.cull(m_camera.frustum, m_camera.position, kDrawDistanceFactor,
+              visible);
+    culled += tree.getStaticCount() - visible.size();
+
+    auto jobs = m_world->jobSystem;
+    if (!jobs || jobs->getWorkerCount() == 0 ||
+        visible.size() <= kInstanceGrainSize) {
+        for (auto instance : visible) {
+            renderInstance(instance, outList);
+        }
+        return;
+    }
+
+    // Every range is exported into its own list, the lists are joined in
+    // order so the result is the same as the serial loop above. The lists
+    // share the memory of the output list through a pool that can be used
+    // from several threads.
+    const auto rangeCount =
+        (visible.size() + kInstanceGrainSize - 1) / kInstanceGrainSize;
+    std::pmr::synchronized_pool_resource rangeMemory(
+        outList.get_allocator().resource());
+    std::pmr::vector<RenderList> rangeLists(rangeCount, &rangeMemory);
+    std::vector<size_t> rangeCulled(rangeCount, 0);
+    jobs->parallelFor(
+        visible.size(), kInstanceGrainSize, [&](size_t begin, size_t end) {
+            RW_PROFILE_SCOPE("renderInstances");
+            const auto range = begin / kInstanceGrainSize;
+            ObjectRenderer renderer(m_world, m_camera, m_renderAlpha);
+            for (auto i = begin; i < end; ++i) {
+                renderer.renderInstance(visible[i], rangeLists[range]);
+            }
+            rangeCulled[range] = renderer.culled;
+        });
+
+    for (auto i = 0u; i < rangeCount; ++i) {
+        outList.insert(outList.end(),
+                       std::make_move_iterator(rangeLists[i].begin()),
+                       std::make_move_iterator(rangeLists[i].end()));
+        culled += rangeCulled[i];
+    }
+}
+
 void ObjectRenderer::buildRenderList(GameObject* object, RenderList& outList) {
     // Right now specialized on each object type
     switch (object->type()) {
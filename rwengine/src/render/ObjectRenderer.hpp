@@ -2,8 +2,11 @@
 #define _RWENGINE_OBJECTRENDERER_HPP_
 
 #include <cstddef>
+#include <utility>
+#include <vector>
 
 #include "render/OpenGLRenderer.hpp"
+#include "render/ViewFrustum.hpp"
 
 class Atomic;
 class CharacterObject;
@@ -12,6 +15,7 @@ class CutsceneObject;
 class GameObject;
 class GameWorld;
 class InstanceObject;
+class InstanceTree;
 class PickupObject;
 class ProjectileObject;
 class VehicleObject;
@@ -41,6 +45,14 @@ public:
     size_t culled = 0;
     void buildRenderList(GameObject* object, RenderList& outList);
 
+    /**
+     * @brief buildRenderList
+     *
+     * Exports rendering instructions for the indexed instances that pass
+     * the tree's frustum and draw distance tests
+     */
+    void buildRenderList(const InstanceTree& tree, RenderList& outList);
+
     void renderGeometry(Geometry* geom, const glm::mat4& modelMatrix,
                         GameObject* object, RenderList& outList);
 
@@ -65,6 +77,10 @@ private:
     const ViewCamera& m_camera;
     float m_renderAlpha;
 
+    /// Scratch space for renderClump
+    ViewFrustum::SphereBatch clumpSpheres;
+    std::vector<std::pair<Atomic*, glm::mat4>> clumpTransforms;
+
     void renderInstance(InstanceObject* instance, RenderList& outList);
     void renderCharacter(CharacterObject* pedestrian, RenderList& outList);
     void renderVehicle(VehicleObject* vehicle, RenderList& outList);
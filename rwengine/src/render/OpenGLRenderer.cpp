@@ -1,6 +1,8 @@
 #include "render/OpenGLRenderer.hpp"
 
+#include <algorithm>
 #include <cstring>
+#include <iterator>
 #include <sstream>
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -8,11 +10,42 @@
 
 #include <core/Profiler.hpp>
 #include <gl/DrawBuffer.hpp>
+#include <gl/StreamBuffer.hpp>
 #include <rw/debug.hpp>
 
 namespace {
 constexpr GLuint kUBOIndexScene = 1;
 constexpr GLuint kUBOIndexDraw = 2;
+
+// Size of the stream buffer, a third of it is written each frame
+constexpr size_t kStreamBufferSize = 12 * 1024 * 1024;
+// Shortest run of identical draws worth switching to the instanced program
+constexpr size_t kMinInstanceRun = 4;
+
+bool canShareInstancedDraw(const Renderer::RenderInstruction& a,
+                           const Renderer::RenderInstruction& b) {
+    const auto& pa = a.drawInfo;
+    const auto& pb = b.drawInfo;
+    return a.dbuff == b.dbuff && pa.start == pb.start &&
+           pa.count == pb.count && pa.baseVertex == pb.baseVertex &&
+           pa.textures == pb.textures && pa.blendMode == pb.blendMode &&
+           pa.depthMode == pb.depthMode && pa.depthWrite == pb.depthWrite &&
+           pa.colour == pb.colour && pa.ambient == pb.ambient &&
+           pa.diffuse == pb.diffuse && pa.visibility == pb.visibility;
+}
+
+// Instructions that can be merged into one multi-draw call, the index ranges
+// may differ but everything else has to match
+bool canMergeDraw(const Renderer::RenderInstruction& a,
+                  const Renderer::RenderInstruction& b) {
+    const auto& pa = a.drawInfo;
+    const auto& pb = b.drawInfo;
+    return a.dbuff == b.dbuff && a.model == b.model &&
+           pa.textures == pb.textures && pa.blendMode == pb.blendMode &&
+           pa.depthMode == pb.depthMode && pa.depthWrite == pb.depthWrite &&
+           pa.colour == pb.colour && pa.ambient == pb.ambient &&
+           pa.diffuse == pb.diffuse && pa.visibility == pb.visibility;
+}
 }
 
 GLuint compileShader(GLenum type, const char* source) {
@@ -107,6 +140,7 @@ void Renderer::swap() {
     drawCounter = 0;
     textureCounter = 0;
     bufferCounter = 0;
+    frameArena.reset();
 }
 
 int Renderer::getDrawCount() {
@@ -209,8 +243,6 @@ OpenGLRenderer::OpenGLRenderer() {
     // We need to query for some profiling exts.
     ogl_CheckExtensions();
 
-    glGenQueries(1, &debugQuery);
-
     createUBO(UBOScene, sizeof(SceneUniformData), sizeof(SceneUniformData));
     glBindBufferBase(GL_UNIFORM_BUFFER, kUBOIndexScene, UBOScene.name);
 
@@ -219,9 +251,22 @@ OpenGLRenderer::OpenGLRenderer() {
 
     createUBO(UBOObject, MaxUBOSize, sizeof(ObjectUniformData));
 
+    streamBuffer = std::make_unique<StreamBuffer>(kStreamBufferSize);
+
     swap();
 }
 
+OpenGLRenderer::~OpenGLRenderer() {
+#ifdef RW_GRAPHICS_STATS
+    for (auto& frame : queryFrames) {
+        if (!frame.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(frame.queries.size()),
+                            frame.queries.data());
+        }
+    }
+#endif
+}
+
 std::string OpenGLRenderer::getIDString() const {
     std::stringstream ss;
     ss << "OpenGL Renderer";
@@ -247,48 +292,98 @@ void OpenGLRenderer::setProgramBlockBinding(Renderer::ShaderProgram* p,
 
 void OpenGLRenderer::setUniformTexture(Renderer::ShaderProgram* p,
                                        const std::string& name, GLint tex) {
-    useProgram(p);
-
-    glUniform1i(currentProgram->getUniformLocation(name), tex);
+    setUniform(getUniform<GLint>(p, name), tex);
 }
 
 void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
                                 const std::string& name, const glm::mat4& m) {
-    useProgram(p);
-
-    glUniformMatrix4fv(currentProgram->getUniformLocation(name.c_str()), 1,
-                       GL_FALSE, glm::value_ptr(m));
+    setUniform(getUniform<glm::mat4>(p, name), m);
 }
 
 void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
                                 const std::string& name, const glm::vec4& m) {
-    useProgram(p);
-
-    glUniform4fv(currentProgram->getUniformLocation(name.c_str()), 1,
-                 glm::value_ptr(m));
+    setUniform(getUniform<glm::vec4>(p, name), m);
 }
 
 void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
                                 const std::string& name, const glm::vec3& m) {
-    useProgram(p);
-
-    glUniform3fv(currentProgram->getUniformLocation(name.c_str()), 1,
-                 glm::value_ptr(m));
+    setUniform(getUniform<glm::vec3>(p, name), m);
 }
 
 void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
                                 const std::string& name, const glm::vec2& m) {
-    useProgram(p);
-
-    glUniform2fv(currentProgram->getUniformLocation(name.c_str()), 1,
-                 glm::value_ptr(m));
+    setUniform(getUniform<glm::vec2>(p, name), m);
 }
 
 void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
                                 const std::string& name, float f) {
-    useProgram(p);
+    setUniform(getUniform<float>(p, name), f);
+}
+
+int OpenGLRenderer::resolveUniform(Renderer::ShaderProgram* p,
+                                   const std::string& name) {
+    return static_cast<OpenGLShaderProgram*>(p)->getUniformIndex(name);
+}
+
+template <class T, class F>
+void OpenGLRenderer::setUniformValue(const UniformHandle<T>& u,
+                                     const T& value, F upload) {
+    static_assert(sizeof(T) <= sizeof(OpenGLShaderProgram::Uniform::value),
+                  "Uniform value too large to cache");
+    useProgram(u.program);
+    if (u.index < 0) {
+        return;
+    }
+
+    auto& uniform = currentProgram->getUniform(u.index);
+    if (uniform.location < 0) {
+        return;
+    }
+    if (uniform.valid &&
+        std::memcmp(uniform.value.data(), &value, sizeof(T)) == 0) {
+        return;
+    }
+    std::memcpy(uniform.value.data(), &value, sizeof(T));
+    uniform.valid = true;
+    upload(uniform.location);
+}
+
+void OpenGLRenderer::setUniform(const UniformHandle<GLint>& u, GLint i) {
+    setUniformValue(u, i, [&](GLint location) { glUniform1i(location, i); });
+}
+
+void OpenGLRenderer::setUniform(const UniformHandle<glm::mat4>& u,
+                                const glm::mat4& m) {
+    setUniformValue(u, m, [&](GLint location) {
+        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(m));
+    });
+}
+
+void OpenGLRenderer::setUniform(const UniformHandle<glm::vec4>& u,
+                                const glm::vec4& v) {
+    setUniformValue(u, v, [&](GLint location) {
+        glUniform4fv(location, 1, glm::value_ptr(v));
+    });
+}
+
+void OpenGLRenderer::setUniform(const UniformHandle<glm::vec3>& u,
+                                const glm::vec3& v) {
+    setUniformValue(u, v, [&](GLint location) {
+        glUniform3fv(location, 1, glm::value_ptr(v));
+    });
+}
+
+void OpenGLRenderer::setUniform(const UniformHandle<glm::vec2>& u,
+                                const glm::vec2& v) {
+    setUniformValue(u, v, [&](GLint location) {
+        glUniform2fv(location, 1, glm::value_ptr(v));
+    });
+}
 
-    glUniform1fv(currentProgram->getUniformLocation(name.c_str()), 1, &f);
+void OpenGLRenderer::setUniform(const UniformHandle<float>& u, float f) {
+    setUniformValue(u, f, [&](GLint location) {
+        glUniform1fv(location, 1, &f);
+    });
 }
 
 void OpenGLRenderer::clear(const glm::vec4& colour, bool clearColour,
@@ -348,9 +443,10 @@ void OpenGLRenderer::draw(const glm::mat4& model, DrawBuffer* draw,
                           const Renderer::DrawParameters& p) {
     setDrawState(model, draw, p);
 
-    glDrawElements(draw->getFaceType(), static_cast<GLsizei>(p.count),
-                   GL_UNSIGNED_INT,
-                   reinterpret_cast<void*>(sizeof(RenderIndex) * p.start));
+    glDrawElementsBaseVertex(
+        draw->getFaceType(), static_cast<GLsizei>(p.count), GL_UNSIGNED_INT,
+        reinterpret_cast<void*>(sizeof(RenderIndex) * p.start),
+        static_cast<GLint>(p.baseVertex));
 }
 
 void OpenGLRenderer::drawArrays(const glm::mat4& model, DrawBuffer* draw,
@@ -411,10 +507,140 @@ void OpenGLRenderer::drawBatched(const RenderList& list) {
 #endif
 }
 
+void OpenGLRenderer::drawBatched(const RenderList& list,
+                                 ShaderProgram* instancedProgram) {
+    if (!instancedProgram || !currentProgram) {
+        drawBatched(list);
+        return;
+    }
+
+    RW_PROFILE_SCOPE(__func__);
+    auto program = currentProgram;
+    for (auto it = list.begin(); it != list.end();) {
+        auto end = std::find_if_not(
+            it + 1, list.end(),
+            [&](const auto& ri) { return canShareInstancedDraw(*it, ri); });
+
+        if (static_cast<size_t>(end - it) >= kMinInstanceRun) {
+            instanceModels.clear();
+            std::transform(it, end, std::back_inserter(instanceModels),
+                           [](const auto& ri) { return ri.model; });
+            useProgram(instancedProgram);
+            drawInstanced(instanceModels.data(), instanceModels.size(),
+                          it->dbuff, it->drawInfo);
+        } else {
+            useProgram(program);
+            end = std::find_if_not(
+                it + 1, list.end(),
+                [&](const auto& ri) { return canMergeDraw(*it, ri); });
+            if (end - it > 1) {
+                drawMerged(it, end);
+            } else {
+                draw(it->model, it->dbuff, it->drawInfo);
+            }
+        }
+
+        it = end;
+    }
+    useProgram(program);
+}
+
+void OpenGLRenderer::drawMerged(RenderList::const_iterator begin,
+                                RenderList::const_iterator end) {
+    multiDrawCounts.clear();
+    multiDrawOffsets.clear();
+    multiDrawBaseVertices.clear();
+
+    auto p = begin->drawInfo;
+    p.count = 0;
+    for (auto ri = begin; ri != end; ++ri) {
+        const auto& dp = ri->drawInfo;
+        multiDrawCounts.push_back(static_cast<GLsizei>(dp.count));
+        multiDrawOffsets.push_back(
+            reinterpret_cast<void*>(sizeof(RenderIndex) * dp.start));
+        multiDrawBaseVertices.push_back(static_cast<GLint>(dp.baseVertex));
+        p.count += dp.count;
+    }
+
+    setDrawState(begin->model, begin->dbuff, p);
+
+    glMultiDrawElementsBaseVertex(
+        begin->dbuff->getFaceType(), multiDrawCounts.data(), GL_UNSIGNED_INT,
+        multiDrawOffsets.data(), static_cast<GLsizei>(multiDrawCounts.size()),
+        multiDrawBaseVertices.data());
+}
+
+template <class F>
+void OpenGLRenderer::forEachInstanceBatch(const glm::mat4* models,
+                                          size_t count, DrawBuffer* draw,
+                                          const Renderer::DrawParameters& p,
+                                          F drawBatch) {
+    while (count > 0) {
+        const auto batch = std::min(
+            count, streamBuffer->getMaxVertices(sizeof(glm::mat4)));
+        const auto offset = streamBuffer->upload(models, batch).offset;
+#ifdef RW_GRAPHICS_STATS
+        if (currentDebugDepth > 0) {
+            profileInfo[currentDebugDepth - 1].uploads++;
+        }
+#endif
+
+        setDrawState(glm::mat4(1.0f), draw, p);
+
+        // The instance attributes live in the VAO, point them at this batch
+        glBindBuffer(GL_ARRAY_BUFFER, streamBuffer->getName());
+        for (GLuint c = 0; c < 4; ++c) {
+            const GLuint index = ATRS_InstanceModel + c;
+            glEnableVertexAttribArray(index);
+            glVertexAttribPointer(
+                index, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                reinterpret_cast<void*>(offset + sizeof(glm::vec4) * c));
+            glVertexAttribDivisor(index, 1);
+        }
+
+        drawBatch(static_cast<GLsizei>(batch));
+
+#ifdef RW_GRAPHICS_STATS
+        if (currentDebugDepth > 0) {
+            // setDrawState only counted the first instance
+            profileInfo[currentDebugDepth - 1].primitives +=
+                p.count * (batch - 1);
+        }
+#endif
+
+        models += batch;
+        count -= batch;
+    }
+}
+
+void OpenGLRenderer::drawInstanced(const glm::mat4* models, size_t count,
+                                   DrawBuffer* draw,
+                                   const Renderer::DrawParameters& p) {
+    forEachInstanceBatch(models, count, draw, p, [&](GLsizei instances) {
+        glDrawElementsInstancedBaseVertex(
+            draw->getFaceType(), static_cast<GLsizei>(p.count),
+            GL_UNSIGNED_INT,
+            reinterpret_cast<void*>(sizeof(RenderIndex) * p.start),
+            instances, static_cast<GLint>(p.baseVertex));
+    });
+}
+
+void OpenGLRenderer::drawArraysInstanced(const glm::mat4* models,
+                                         size_t count, DrawBuffer* draw,
+                                         const Renderer::DrawParameters& p) {
+    forEachInstanceBatch(models, count, draw, p, [&](GLsizei instances) {
+        glDrawArraysInstanced(draw->getFaceType(),
+                              static_cast<GLint>(p.start),
+                              static_cast<GLsizei>(p.count), instances);
+    });
+}
+
 void OpenGLRenderer::invalidate() {
     currentDbuff = nullptr;
     currentProgram = nullptr;
     currentTextures.clear();
+    glActiveTexture(GL_TEXTURE0);
+    currentUnit = 0;
     currentUBO = 0;
     setBlend(BlendMode::BLEND_NONE);
     setDepthMode(DepthMode::OFF);
@@ -474,6 +700,71 @@ void OpenGLRenderer::uploadUBOEntry(Buffer &buffer, const void *data, size_t siz
     }
 }
 
+void OpenGLRenderer::swap() {
+    Renderer::swap();
+    streamBuffer->nextFrame();
+#ifdef RW_GRAPHICS_STATS
+    RW_ASSERT(currentDebugDepth == 0);
+
+    // The oldest frame in the ring is reused for the next one
+    currentQueryFrame = (currentQueryFrame + 1) % kQueryFrameCount;
+    auto& frame = queryFrames[currentQueryFrame];
+    resolveQueries(frame);
+
+    frame.frame = ++frameCount;
+    frame.usedQueries = 0;
+    frame.groups.clear();
+    frame.groupQueries.clear();
+#endif
+}
+
+#ifdef RW_GRAPHICS_STATS
+size_t OpenGLRenderer::issueTimestamp() {
+    auto& frame = queryFrames[currentQueryFrame];
+    if (frame.usedQueries == frame.queries.size()) {
+        GLuint query;
+        glGenQueries(1, &query);
+        frame.queries.push_back(query);
+    }
+    glQueryCounter(frame.queries[frame.usedQueries], GL_TIMESTAMP);
+    return frame.usedQueries++;
+}
+
+void OpenGLRenderer::resolveQueries(QueryFrame& frame) {
+    if (frame.groups.empty()) {
+        return;
+    }
+
+    // Timestamps complete in order, if the last one is available so are
+    // the others. Should the GPU be this far behind, skip the frame rather
+    // than wait for it.
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(frame.queries[frame.usedQueries - 1],
+                       GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == GL_FALSE) {
+        return;
+    }
+
+    FrameProfile profile;
+    profile.frame = frame.frame;
+    profile.groups = std::move(frame.groups);
+    for (auto i = 0u; i < profile.groups.size(); ++i) {
+        auto& info = profile.groups[i].info;
+        GLuint64 end;
+        glGetQueryObjectui64v(frame.queries[frame.groupQueries[i].first],
+                              GL_QUERY_RESULT, &info.timerStart);
+        glGetQueryObjectui64v(frame.queries[frame.groupQueries[i].second],
+                              GL_QUERY_RESULT, &end);
+        info.duration = end - info.timerStart;
+    }
+
+    profileHistory.push_back(std::move(profile));
+    if (profileHistory.size() > kProfileHistorySize) {
+        profileHistory.pop_front();
+    }
+}
+#endif
+
 void OpenGLRenderer::pushDebugGroup(const std::string& title) {
 #ifdef RW_GRAPHICS_STATS
     if (ogl_ext_KHR_debug) {
@@ -482,8 +773,10 @@ void OpenGLRenderer::pushDebugGroup(const std::string& title) {
         prof.buffers = prof.draws = prof.textures = prof.uploads =
             prof.primitives = 0;
 
-        glQueryCounter(debugQuery, GL_TIMESTAMP);
-        glGetQueryObjectui64v(debugQuery, GL_QUERY_RESULT, &prof.timerStart);
+        auto& frame = queryFrames[currentQueryFrame];
+        openGroups[currentDebugDepth] = frame.groups.size();
+        frame.groups.push_back({title, currentDebugDepth, {}});
+        frame.groupQueries.emplace_back(issueTimestamp(), 0);
 
         currentDebugDepth++;
         RW_ASSERT(currentDebugDepth < MAX_DEBUG_DEPTH);
@@ -502,11 +795,24 @@ const Renderer::ProfileInfo& OpenGLRenderer::popDebugGroup() {
 
         ProfileInfo& prof = profileInfo[currentDebugDepth];
 
-        glQueryCounter(debugQuery, GL_TIMESTAMP);
-        GLuint64 current_time;
-        glGetQueryObjectui64v(debugQuery, GL_QUERY_RESULT, &current_time);
-
-        prof.duration = current_time - prof.timerStart;
+        auto& frame = queryFrames[currentQueryFrame];
+        const auto group = openGroups[currentDebugDepth];
+        frame.groupQueries[group].second = issueTimestamp();
+        frame.groups[group].info = prof;
+
+        // The GPU time is only known for earlier frames
+        prof.timerStart = prof.duration = 0;
+        if (!profileHistory.empty()) {
+            const auto& title = frame.groups[group].title;
+            for (const auto& resolved : profileHistory.back().groups) {
+                if (resolved.depth == currentDebugDepth &&
+                    resolved.title == title) {
+                    prof.timerStart = resolved.info.timerStart;
+                    prof.duration = resolved.info.duration;
+                    break;
+                }
+            }
+        }
 
         // Add counters to the parent group
         if (currentDebugDepth > 0) {
@@ -526,14 +832,14 @@ const Renderer::ProfileInfo& OpenGLRenderer::popDebugGroup() {
 
 Renderer::ShaderProgram::~ShaderProgram() = default;
 
-GLint OpenGLRenderer::OpenGLShaderProgram::getUniformLocation(const std::string &name) {
-    auto c = uniforms.find(name.c_str());
-    GLint loc = -1;
-    if (c == uniforms.end()) {
-        loc = glGetUniformLocation(program, name.c_str());
-        uniforms[name] = loc;
-    } else {
-        loc = c->second;
+int OpenGLRenderer::OpenGLShaderProgram::getUniformIndex(
+    const std::string& name) {
+    auto it = uniformIndices.find(name);
+    if (it != uniformIndices.end()) {
+        return it->second;
     }
-    return loc;
+    const auto index = static_cast<int>(uniforms.size());
+    uniforms.push_back({glGetUniformLocation(program, name.c_str())});
+    uniformIndices.emplace(name, index);
+    return index;
 }
@@ -3,12 +3,15 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <array>
 
+#include <core/FrameArena.hpp>
 #include <gl/GeometryBuffer.hpp>
 
 #include <glm/gtc/type_precision.hpp>
@@ -17,9 +20,15 @@
 #include <glm/vec4.hpp>
 
 class DrawBuffer;
+class StreamBuffer;
 
 typedef uint64_t RenderKey;
 
+// A coarse depth bucket is stored in the bits of a RenderKey above this,
+// opaque draws are sorted front to back by bucket before state
+constexpr unsigned kRenderKeyBucketShift = 32;
+constexpr unsigned kRenderKeyBucketCount = 16;
+
 // Maximum depth of debug group stack
 #define MAX_DEBUG_DEPTH 5
 
@@ -88,6 +97,8 @@ public:
         size_t count{};
         /// Start index.
         size_t start{};
+        /// Added to each index before fetching vertices
+        size_t baseVertex{};
         /// Textures to use
         Textures textures{};
         /// Blending mode
@@ -128,7 +139,7 @@ public:
             : sortKey(key), model(model), dbuff(dbuff), drawInfo(dp) {
         }
     };
-    typedef std::vector<RenderInstruction> RenderList;
+    typedef std::pmr::vector<RenderInstruction> RenderList;
 
     struct ObjectUniformData {
         glm::mat4 model{1.0f};
@@ -155,6 +166,17 @@ public:
             virtual ~ShaderProgram() = 0;
     };
 
+    /**
+     * A uniform of type T in a program, resolved once by getUniform so
+     * setting it doesn't look the name up again. Setting a uniform to the
+     * value it already has is skipped.
+     */
+    template <class T>
+    struct UniformHandle {
+        ShaderProgram* program = nullptr;
+        int index = -1;
+    };
+
     virtual ~Renderer() = default;
 
     virtual std::string getIDString() const = 0;
@@ -181,6 +203,27 @@ public:
     virtual void setUniform(ShaderProgram* p, const std::string& name,
                             float f) = 0;
 
+    template <class T>
+    UniformHandle<T> getUniform(ShaderProgram* p, const std::string& name) {
+        return {p, resolveUniform(p, name)};
+    }
+
+    /**
+     * @return the index of the named uniform in the value cache of p
+     */
+    virtual int resolveUniform(ShaderProgram* p, const std::string& name) = 0;
+
+    virtual void setUniform(const UniformHandle<GLint>& u, GLint i) = 0;
+    virtual void setUniform(const UniformHandle<glm::mat4>& u,
+                            const glm::mat4& m) = 0;
+    virtual void setUniform(const UniformHandle<glm::vec4>& u,
+                            const glm::vec4& v) = 0;
+    virtual void setUniform(const UniformHandle<glm::vec3>& u,
+                            const glm::vec3& v) = 0;
+    virtual void setUniform(const UniformHandle<glm::vec2>& u,
+                            const glm::vec2& v) = 0;
+    virtual void setUniform(const UniformHandle<float>& u, float f) = 0;
+
     virtual void clear(const glm::vec4& colour, bool clearColour = true,
                        bool clearDepth = true) = 0;
 
@@ -193,6 +236,31 @@ public:
 
     virtual void drawBatched(const RenderList& list) = 0;
 
+    /**
+     * Draws the list, merging consecutive instructions that share the same
+     * DrawBuffer and DrawParameters into a single instanced draw using
+     * instancedProgram. Instructions that can't be merged are drawn with
+     * the current program.
+     */
+    virtual void drawBatched(const RenderList& list,
+                             ShaderProgram* instancedProgram) = 0;
+
+    /**
+     * Draws count instances of the same geometry, one per model matrix.
+     * The current program must read the model matrix from the
+     * ATRS_InstanceModel attribute.
+     */
+    virtual void drawInstanced(const glm::mat4* models, size_t count,
+                               DrawBuffer* draw, const DrawParameters& p) = 0;
+
+    /**
+     * Non-indexed variant of drawInstanced, each instance draws the vertex
+     * range of p.
+     */
+    virtual void drawArraysInstanced(const glm::mat4* models, size_t count,
+                                     DrawBuffer* draw,
+                                     const DrawParameters& p) = 0;
+
     void setViewport(const glm::ivec2& vp);
     const glm::ivec2& getViewport() const {
         return viewport;
@@ -205,9 +273,22 @@ public:
     virtual void invalidate() = 0;
 
     /**
-     * Resets all per-frame counters.
+     * The shared buffer for geometry rewritten every frame
      */
-    void swap();
+    virtual StreamBuffer& getStreamBuffer() = 0;
+
+    /**
+     * Resets all per-frame counters and the frame arena.
+     */
+    virtual void swap();
+
+    /**
+     * Memory for containers that are rebuilt every frame, such as render
+     * lists. Everything in it is released by swap().
+     */
+    FrameArena& getFrameArena() {
+        return frameArena;
+    }
 
     /**
      * Returns the number of draw calls issued for the current frame.
@@ -233,6 +314,25 @@ public:
         unsigned int uploads{};
     };
 
+    /**
+     * Profiling data of one debug group in a frame
+     */
+    struct GroupProfile {
+        std::string title;
+        /// Number of enclosing groups
+        int depth{};
+        ProfileInfo info{};
+    };
+
+    struct FrameProfile {
+        uint64_t frame{};
+        /// In the order the groups were pushed
+        std::vector<GroupProfile> groups;
+    };
+
+    /// Number of frames kept in the profile history
+    static constexpr size_t kProfileHistorySize = 120;
+
     /**
      * Signals the start of a debug group
      */
@@ -240,26 +340,49 @@ public:
     /**
      * Ends the current debug group and returns the profiling information
      * for that group. The returned value is valid until the next call to
-     * pushDebugGroup
+     * pushDebugGroup. GPU timings take a few frames to arrive, so the
+     * duration is that of the same group in the latest resolved frame.
      */
     virtual const ProfileInfo& popDebugGroup() = 0;
 
+    /**
+     * Profiles of recent frames with their GPU timings, oldest first
+     */
+    const std::deque<FrameProfile>& getProfileHistory() const {
+        return profileHistory;
+    }
+
 private:
     glm::ivec2 viewport{};
     glm::mat4 projection2D{1.0f};
 
 protected:
+    /// Initial size of the frame arena, it grows to fit the busiest frame
+    static constexpr size_t kFrameArenaSize = 1024 * 1024;
+
     int drawCounter{};
     int textureCounter{};
     int bufferCounter{};
     SceneUniformData lastSceneData{};
+    std::deque<FrameProfile> profileHistory;
+    FrameArena frameArena{kFrameArenaSize};
 };
 
 class OpenGLRenderer final : public Renderer {
 public:
     class OpenGLShaderProgram final : public ShaderProgram {
+    public:
+        struct Uniform {
+            GLint location;
+            bool valid = false;
+            /// The last value set, large enough for a mat4
+            std::array<float, 16> value{};
+        };
+
+    private:
         GLuint program;
-        std::map<std::string, GLint> uniforms;
+        std::map<std::string, int> uniformIndices;
+        std::vector<Uniform> uniforms;
 
     public:
         OpenGLShaderProgram(GLuint p) : program(p) {
@@ -273,12 +396,16 @@ public:
             return program;
         }
 
-        GLint getUniformLocation(const std::string& name);
+        int getUniformIndex(const std::string& name);
+
+        Uniform& getUniform(int index) {
+            return uniforms[index];
+        }
     };
 
     OpenGLRenderer();
 
-    ~OpenGLRenderer() override = default;
+    ~OpenGLRenderer() override;
 
     std::string getIDString() const override;
 
@@ -298,6 +425,20 @@ public:
                     const glm::vec2& m) override;
     void setUniform(ShaderProgram* p, const std::string& name,
                     float f) override;
+
+    int resolveUniform(ShaderProgram* p, const std::string& name) override;
+
+    void setUniform(const UniformHandle<GLint>& u, GLint i) override;
+    void setUniform(const UniformHandle<glm::mat4>& u,
+                    const glm::mat4& m) override;
+    void setUniform(const UniformHandle<glm::vec4>& u,
+                    const glm::vec4& v) override;
+    void setUniform(const UniformHandle<glm::vec3>& u,
+                    const glm::vec3& v) override;
+    void setUniform(const UniformHandle<glm::vec2>& u,
+                    const glm::vec2& v) override;
+    void setUniform(const UniformHandle<float>& u, float f) override;
+
     void useProgram(ShaderProgram* p) override;
 
     void clear(const glm::vec4& colour, bool clearColour = true,
@@ -314,9 +455,23 @@ public:
                     const DrawParameters& p) override;
 
     void drawBatched(const RenderList& list) override;
+    void drawBatched(const RenderList& list,
+                     ShaderProgram* instancedProgram) override;
+
+    void drawInstanced(const glm::mat4* models, size_t count,
+                       DrawBuffer* draw, const DrawParameters& p) override;
+    void drawArraysInstanced(const glm::mat4* models, size_t count,
+                             DrawBuffer* draw,
+                             const DrawParameters& p) override;
 
     void invalidate() override;
 
+    StreamBuffer& getStreamBuffer() override {
+        return *streamBuffer;
+    }
+
+    void swap() override;
+
     void pushDebugGroup(const std::string& title) override;
 
     const ProfileInfo& popDebugGroup() override;
@@ -338,6 +493,15 @@ private:
     Buffer UBOObject {};
     Buffer UBOScene {};
 
+    /// Transient vertices and per-instance model matrices
+    std::unique_ptr<StreamBuffer> streamBuffer;
+    std::vector<glm::mat4> instanceModels;
+
+    /// Scratch arrays for glMultiDrawElementsBaseVertex
+    std::vector<GLsizei> multiDrawCounts;
+    std::vector<const void*> multiDrawOffsets;
+    std::vector<GLint> multiDrawBaseVertices;
+
     // State Cache
     DrawBuffer* currentDbuff = nullptr;
     OpenGLShaderProgram* currentProgram = nullptr;
@@ -355,6 +519,13 @@ private:
 
     void setDepthWrite(bool enable);
 
+    /**
+     * Binds the program of u and calls upload with the location, unless
+     * the uniform already has the value
+     */
+    template <class T, class F>
+    void setUniformValue(const UniformHandle<T>& u, const T& value, F upload);
+
     template <class T>
     void uploadUBO(Buffer& buffer, const T& data) {
         uploadUBOEntry(buffer, &data, sizeof(T));
@@ -372,11 +543,54 @@ private:
 
     void uploadUBOEntry(Buffer& buffer, const void *data, size_t size);
 
+    /**
+     * Uploads the matrices in batches that fit streamBuffer and calls
+     * drawBatch with the instance count of each, after pointing the
+     * instance attributes of the draw buffer at the batch.
+     */
+    template <class F>
+    void forEachInstanceBatch(const glm::mat4* models, size_t count,
+                              DrawBuffer* draw, const DrawParameters& p,
+                              F drawBatch);
+
+    /**
+     * Draws a run of instructions that only differ in their index ranges
+     * with one multi-draw call.
+     */
+    void drawMerged(RenderList::const_iterator begin,
+                    RenderList::const_iterator end);
+
     // Debug group profiling timers
     ProfileInfo profileInfo[MAX_DEBUG_DEPTH];
-    GLuint debugQuery;
 #ifdef RW_GRAPHICS_STATS
     int currentDebugDepth = 0;
+
+    /// Frames recorded before their timestamps are read back
+    static constexpr size_t kQueryFrameCount = 4;
+
+    /**
+     * Timestamp queries issued during a frame. Reading them back right away
+     * would stall until the GPU caught up, so they are read when the frame
+     * comes around again.
+     */
+    struct QueryFrame {
+        uint64_t frame{};
+        std::vector<GLuint> queries;
+        size_t usedQueries{};
+        std::vector<GroupProfile> groups;
+        /// Indices of the start and end query of each group
+        std::vector<std::pair<size_t, size_t>> groupQueries;
+    };
+
+    std::array<QueryFrame, kQueryFrameCount> queryFrames;
+    size_t currentQueryFrame = 0;
+    uint64_t frameCount = 0;
+    /// Index into the current frame's groups of each open group
+    size_t openGroups[MAX_DEBUG_DEPTH]{};
+
+    size_t issueTimestamp();
+
+    void resolveQueries(QueryFrame& frame);
 #endif
 };
 
@@ -0,0 +1,154 @@
+#include "render/ParticleSystem.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#include <glm/gtx/norm.hpp>
+
+ParticleSystem::Handle ParticleSystem::spawn(const ParticleFX& particle) {
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slots.size());
+        slots.push_back({Handle::kInvalid, 0});
+    }
+
+    const auto index = static_cast<uint32_t>(positions.size());
+    slots[slot].particle = index;
+
+    positions.push_back(particle.position);
+    velocities.push_back(particle.velocity);
+    ups.push_back(particle.up);
+    sizes.push_back(particle.size);
+    colours.push_back(particle.colour);
+    expiryTimes.push_back(particle.lifetime >= 0.f
+                              ? particle.starttime + particle.lifetime
+                              : -1.f);
+    textures.push_back(particle.texture);
+    orientations.push_back(particle.orientation);
+    particleSlots.push_back(slot);
+
+    return {slot, slots[slot].generation};
+}
+
+uint32_t ParticleSystem::find(Handle handle) const {
+    if (handle.slot >= slots.size() ||
+        slots[handle.slot].generation != handle.generation) {
+        return Handle::kInvalid;
+    }
+    return slots[handle.slot].particle;
+}
+
+bool ParticleSystem::isAlive(Handle handle) const {
+    return find(handle) != Handle::kInvalid;
+}
+
+void ParticleSystem::destroy(Handle handle) {
+    const auto particle = find(handle);
+    if (particle != Handle::kInvalid) {
+        remove(particle);
+    }
+}
+
+void ParticleSystem::remove(uint32_t particle) {
+    const auto slot = particleSlots[particle];
+    slots[slot].particle = Handle::kInvalid;
+    slots[slot].generation++;
+    freeSlots.push_back(slot);
+
+    const auto last = static_cast<uint32_t>(positions.size() - 1);
+    if (particle != last) {
+        positions[particle] = positions[last];
+        velocities[particle] = velocities[last];
+        ups[particle] = ups[last];
+        sizes[particle] = sizes[last];
+        colours[particle] = colours[last];
+        expiryTimes[particle] = expiryTimes[last];
+        textures[particle] = textures[last];
+        orientations[particle] = orientations[last];
+        particleSlots[particle] = particleSlots[last];
+        slots[particleSlots[particle]].particle = particle;
+    }
+
+    positions.pop_back();
+    velocities.pop_back();
+    ups.pop_back();
+    sizes.pop_back();
+    colours.pop_back();
+    expiryTimes.pop_back();
+    textures.pop_back();
+    orientations.pop_back();
+    particleSlots.pop_back();
+}
+
+void ParticleSystem::setPosition(Handle handle, const glm::vec3& position) {
+    const auto particle = find(handle);
+    if (particle != Handle::kInvalid) {
+        positions[particle] = position;
+    }
+}
+
+void ParticleSystem::setSize(Handle handle, const glm::vec2& size) {
+    const auto particle = find(handle);
+    if (particle != Handle::kInvalid) {
+        sizes[particle] = size;
+    }
+}
+
+void ParticleSystem::setColour(Handle handle, const glm::vec4& colour) {
+    const auto particle = find(handle);
+    if (particle != Handle::kInvalid) {
+        colours[particle] = colour;
+    }
+}
+
+void ParticleSystem::update(float gameTime, float dt) {
+    for (uint32_t i = 0; i < positions.size();) {
+        const auto expiry = expiryTimes[i];
+        if (expiry >= 0.f && gameTime >= expiry) {
+            // The last particle takes its place and is visited next
+            remove(i);
+            continue;
+        }
+        positions[i] += velocities[i] * dt;
+        ++i;
+    }
+}
+
+void ParticleSystem::clear() {
+    for (auto slot : particleSlots) {
+        slots[slot].particle = Handle::kInvalid;
+        slots[slot].generation++;
+        freeSlots.push_back(slot);
+    }
+
+    positions.clear();
+    velocities.clear();
+    ups.clear();
+    sizes.clear();
+    colours.clear();
+    expiryTimes.clear();
+    textures.clear();
+    orientations.clear();
+    particleSlots.clear();
+}
+
+void ParticleSystem::buildDrawOrder(const glm::vec3& cameraPosition,
+                                    std::vector<DrawKey>& keys) const {
+    keys.clear();
+    keys.reserve(positions.size());
+    for (uint32_t i = 0; i < positions.size(); ++i) {
+        keys.push_back(
+            {textures[i], glm::distance2(positions[i], cameraPosition), i});
+    }
+
+    std::sort(keys.begin(), keys.end(),
+              [](const DrawKey& a, const DrawKey& b) {
+                  if (a.texture != b.texture) {
+                      return std::less<TextureData*>()(a.texture, b.texture);
+                  }
+                  return a.depth > b.depth;
+              });
+}
@@ -0,0 +1,119 @@
+#ifndef _RWENGINE_PARTICLESYSTEM_HPP_
+#define _RWENGINE_PARTICLESYSTEM_HPP_
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <render/VisualFX.hpp>
+
+/**
+ * @brief Owns the live particles of the world
+ *
+ * Particles are stored as parallel arrays that stay densely packed, a
+ * particle that expires or is destroyed is replaced by the last one. Handles
+ * refer to a slot that maps to the particle's current position in the
+ * arrays, slots are recycled through a free list and carry a generation so
+ * handles to particles that have gone don't affect the particle reusing
+ * the slot.
+ */
+class ParticleSystem {
+public:
+    struct Handle {
+        static constexpr uint32_t kInvalid =
+            std::numeric_limits<uint32_t>::max();
+
+        uint32_t slot = kInvalid;
+        uint32_t generation = 0;
+    };
+
+    /**
+     * A particle in the order it should be drawn
+     */
+    struct DrawKey {
+        TextureData* texture;
+        /// Squared distance to the camera
+        float depth;
+        /// Index into the particle arrays
+        uint32_t particle;
+    };
+
+    Handle spawn(const ParticleFX& particle);
+
+    /**
+     * Removes the particle immediately, does nothing if it has expired
+     */
+    void destroy(Handle handle);
+
+    bool isAlive(Handle handle) const;
+
+    void setPosition(Handle handle, const glm::vec3& position);
+    void setSize(Handle handle, const glm::vec2& size);
+    void setColour(Handle handle, const glm::vec4& colour);
+
+    /**
+     * Moves the particles by their velocity and removes the expired ones
+     */
+    void update(float gameTime, float dt);
+
+    void clear();
+
+    size_t size() const {
+        return positions.size();
+    }
+
+    /**
+     * Fills keys with every particle, grouped by texture and sorted from
+     * farthest to nearest within each group
+     */
+    void buildDrawOrder(const glm::vec3& cameraPosition,
+                        std::vector<DrawKey>& keys) const;
+
+    const glm::vec3& getPosition(uint32_t particle) const {
+        return positions[particle];
+    }
+    const glm::vec3& getUp(uint32_t particle) const {
+        return ups[particle];
+    }
+    const glm::vec2& getSize(uint32_t particle) const {
+        return sizes[particle];
+    }
+    const glm::vec4& getColour(uint32_t particle) const {
+        return colours[particle];
+    }
+    ParticleFX::Orientation getOrientation(uint32_t particle) const {
+        return orientations[particle];
+    }
+
+private:
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> velocities;
+    std::vector<glm::vec3> ups;
+    std::vector<glm::vec2> sizes;
+    std::vector<glm::vec4> colours;
+    /// Game time the particle expires at, negative if it never does
+    std::vector<float> expiryTimes;
+    std::vector<TextureData*> textures;
+    std::vector<ParticleFX::Orientation> orientations;
+    /// Slot of each particle
+    std::vector<uint32_t> particleSlots;
+
+    struct Slot {
+        uint32_t particle;
+        uint32_t generation;
+    };
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+
+    /// @return the particle index of handle, or kInvalid
+    uint32_t find(Handle handle) const;
+
+    void remove(uint32_t particle);
+};
+
+#endif
@@ -4,10 +4,12 @@
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <vector>
 
 #include <gl/gl_core_3_3.h>
+#include <gl/StreamBuffer.hpp>
 
 #include "engine/GameData.hpp"
 #include "render/GameRenderer.hpp"
@@ -116,34 +118,21 @@ glm::vec4 indexToTexCoord(size_t index, const glm::u32vec2 &textureSize,
     return glm::vec4(s, t, p, q);
 }
 
-struct TextVertex {
-    glm::vec2 position;
-    glm::vec2 texcoord;
-    glm::vec3 colour;
-
-    TextVertex(glm::vec2 _position, glm::vec2 _texcoord, glm::vec3 _colour)
-        : position(_position), texcoord(_texcoord), colour(_colour) {
-    }
-
-    TextVertex() = default;
-
-    static const AttributeList vertex_attributes() {
-        return {
-            {ATRS_Position, 2, sizeof(TextVertex), 0ul},
-            {ATRS_TexCoord, 2, sizeof(TextVertex), 0ul + sizeof(glm::vec2)},
-            {ATRS_Colour, 3, sizeof(TextVertex), 0ul + sizeof(glm::vec2) * 2},
-        };
-    }
-};
 }  // namespace
 
 TextRenderer::TextRenderer(GameRenderer &renderer) : renderer(renderer) {
-    textShader = renderer.getRenderer().createShader(TextVertexShader,
-                                                     TextFragmentShader);
+    auto& r = renderer.getRenderer();
+    textShader = r.createShader(TextVertexShader, TextFragmentShader);
+    textProj = r.getUniform<glm::mat4>(textShader.get(), "proj");
+    textAlignment = r.getUniform<glm::vec2>(textShader.get(), "alignment");
+    r.setUniformTexture(textShader.get(), "fontTexture", 0);
+    r.getStreamBuffer().bind(db, TextVertex::vertex_attributes());
+    db.setFaceType(GL_TRIANGLES);
 }
 
 void TextRenderer::setFontTexture(font_t font, const std::string& textureName) {
-    auto fTexturePtr = renderer.getData().findSlotTexture("fonts", textureName);
+    auto fTexturePtr =
+        renderer.getData().findSlotTexture("fonts"_nid, NameId(textureName));
     const glm::u32vec2 textureSize = fTexturePtr->getSize();
     glm::u8vec2 glyphOffset{textureSize.x / 16, textureSize.x / 16};
     if (font != FONT_PAGER) {
@@ -168,8 +157,11 @@ void TextRenderer::setFontTexture(font_t font, const std::string& textureName) {
         monoWidth = 1 + *std::max_element(fontWidthsPager.cbegin(),
                                           fontWidthsPager.cend());
     }
+    // Cached layouts used the previous glyph metrics
+    layouts.clear();
+
     fonts[font] = FontMetaData{
-        textureName,
+        NameId::intern(textureName),
         *glyphWidths,
         textureSize,
         glyphOffset,
@@ -177,24 +169,55 @@ void TextRenderer::setFontTexture(font_t font, const std::string& textureName) {
     };
 }
 
-void TextRenderer::renderText(const TextRenderer::TextInfo& ti,
-                              bool forceColour) {
-    if (ti.text.empty() || ti.text[0] == '*')
-        return;
+size_t TextRenderer::LayoutKeyHash::operator()(const LayoutKey& key) const {
+    // FNV-1a over the characters and the parameters that shape the layout
+    size_t hash = 2166136261u;
+    auto mix = [&hash](size_t value) {
+        hash ^= value;
+        hash *= 16777619u;
+    };
+    for (auto c : key.text) {
+        mix(c);
+    }
+    uint32_t sizeBits;
+    std::memcpy(&sizeBits, &key.size, sizeof(sizeBits));
+    mix(sizeBits);
+    mix(static_cast<size_t>(key.font));
+    mix(static_cast<size_t>(key.wrapX));
+    mix((key.colour.r << 16) | (key.colour.g << 8) | key.colour.b);
+    mix(key.forceColour);
+    return hash;
+}
 
-    renderer.getRenderer().pushDebugGroup("Text");
-    renderer.getRenderer().useProgram(textShader.get());
+const TextRenderer::TextLayout& TextRenderer::getLayout(const TextInfo& ti,
+                                                        bool forceColour) {
+    LayoutKey key{ti.text,  ti.font,         ti.size,
+                  ti.wrapX, ti.baseColour, forceColour};
+    auto it = layouts.find(key);
+    if (it != layouts.end()) {
+        return it->second;
+    }
+
+    // Strings that change every frame would otherwise fill the cache
+    if (layouts.size() >= kMaxCachedLayouts) {
+        layouts.clear();
+    }
+    return layouts.emplace(std::move(key), layoutText(ti, forceColour))
+        .first->second;
+}
+
+TextRenderer::TextLayout TextRenderer::layoutText(const TextInfo& ti,
+                                                  bool forceColour) const {
+    TextLayout layout;
 
     glm::vec2 coord(0.f, 0.f);
-    glm::vec2 alignment = ti.screenPosition;
     // We should track real size not just chars.
     auto lineLength = 0;
 
     glm::vec2 ss(ti.size);
 
     glm::vec3 colour = glm::vec3(ti.baseColour) * (1 / 255.f);
-    glm::vec4 colourBG = glm::vec4(ti.backgroundColour) * (1 / 255.f);
-    std::vector<TextVertex> geo;
+    auto& geo = layout.vertices;
 
     float maxWidth = 0.f;
     float maxHeight = ss.y;
@@ -316,39 +339,104 @@ void TextRenderer::renderText(const TextRenderer::TextInfo& ti,
         geo.emplace_back(glm::vec2{p.x + ss.x, p.y + ss.y}, glm::vec2{tex.z, tex.w}, colour);
     }
 
+    layout.extents = {maxWidth, maxHeight};
+    layout.glyphSize = ss;
+    return layout;
+}
+
+void TextRenderer::renderText(const TextRenderer::TextInfo& ti,
+                              bool forceColour) {
+    if (ti.text.empty() || ti.text[0] == '*')
+        return;
+
+    const auto& layout = getLayout(ti, forceColour);
+
+    glm::vec2 alignment = ti.screenPosition;
     if (ti.align == TextInfo::TextAlignment::Right) {
-        alignment.x -= maxWidth;
+        alignment.x -= layout.extents.x;
     } else if (ti.align == TextInfo::TextAlignment::Center) {
-        alignment.x -= (maxWidth / 2.f);
+        alignment.x -= (layout.extents.x / 2.f);
     }
 
     alignment.y -= ti.size * 0.2f;
 
     // If we need to, draw the background.
+    glm::vec4 colourBG = glm::vec4(ti.backgroundColour) * (1 / 255.f);
     if (colourBG.a > 0.f) {
+        // Draw the text collected so far first, or the background covers it
+        flushBatch();
         renderer.drawColour(
-            colourBG, glm::vec4(ti.screenPosition - (ss / 3.f),
-                                glm::vec2(maxWidth, maxHeight) + (ss / 2.f)));
+            colourBG, glm::vec4(ti.screenPosition - (layout.glyphSize / 3.f),
+                                layout.extents + (layout.glyphSize / 2.f)));
     }
 
-    renderer.getRenderer().setUniform(
-        textShader.get(), "proj", renderer.getRenderer().get2DProjection());
-    renderer.getRenderer().setUniformTexture(textShader.get(), "fontTexture", 0);
-    renderer.getRenderer().setUniform(textShader.get(), "alignment", alignment);
+    if (layout.vertices.empty()) {
+        return;
+    }
 
-    gb.uploadVertices(geo);
-    db.addGeometry(&gb);
-    db.setFaceType(GL_TRIANGLES);
+    if (!batching) {
+        const BatchRun run{ti.font, 0, layout.vertices.size()};
+        draw(layout.vertices, alignment, &run, 1);
+        return;
+    }
+
+    const auto start = batchVertices.size();
+    for (const auto& vertex : layout.vertices) {
+        batchVertices.emplace_back(vertex.position + alignment,
+                                   vertex.texcoord, vertex.colour);
+    }
+    if (!batchRuns.empty() && batchRuns.back().font == ti.font) {
+        batchRuns.back().count += layout.vertices.size();
+    } else {
+        batchRuns.push_back({ti.font, start, layout.vertices.size()});
+    }
+}
+
+void TextRenderer::beginBatch() {
+    batching = true;
+}
+
+void TextRenderer::endBatch() {
+    flushBatch();
+    batching = false;
+}
+
+void TextRenderer::flushBatch() {
+    if (batchVertices.empty()) {
+        return;
+    }
+    draw(batchVertices, glm::vec2(0.f), batchRuns.data(), batchRuns.size());
+    batchVertices.clear();
+    batchRuns.clear();
+}
+
+void TextRenderer::draw(const std::vector<TextVertex>& vertices,
+                        const glm::vec2& alignment, const BatchRun* runs,
+                        size_t runCount) {
+    auto& r = renderer.getRenderer();
+    r.pushDebugGroup("Text");
+    r.useProgram(textShader.get());
+
+    r.setUniform(textProj, r.get2DProjection());
+    r.setUniform(textAlignment, alignment);
+
+    const auto allocation =
+        r.getStreamBuffer().upload(vertices.data(), vertices.size());
 
     Renderer::DrawParameters dp;
-    dp.start = 0;
     dp.blendMode = BlendMode::BLEND_ALPHA;
-    dp.count = gb.getCount();
-    auto fTexturePtr = renderer.getData().findSlotTexture("fonts", fontMetaData.textureName);
-    dp.textures = {{fTexturePtr->getName()}};
     dp.depthMode = DepthMode::OFF;
 
-    renderer.getRenderer().drawArrays(glm::mat4(1.0f), &db, dp);
+    for (size_t i = 0; i < runCount; ++i) {
+        const auto& run = runs[i];
+        auto fTexturePtr = renderer.getData().findSlotTexture(
+            "fonts"_nid, fonts[run.font].textureName);
+        dp.start = allocation.baseVertex + run.start;
+        dp.count = run.count;
+        dp.textures = {{fTexturePtr->getName()}};
+
+        r.drawArrays(glm::mat4(1.0f), &db, dp);
+    }
 
-    renderer.getRenderer().popDebugGroup();
+    r.popDebugGroup();
 }
@@ -2,12 +2,15 @@
 #define _RWENGINE_TEXTRENDERER_HPP_
 
 #include <array>
+#include <cstddef>
 #include <memory>
 #include <string>
-#include <array>
+#include <unordered_map>
+#include <vector>
 
 #include <gl/DrawBuffer.hpp>
 #include <gl/GeometryBuffer.hpp>
+#include <rw/StringId.hpp>
 
 #include <fonts/GameTexts.hpp>
 #include <render/OpenGLRenderer.hpp>
@@ -16,8 +19,10 @@ class GameRenderer;
 /**
  * @brief Handles rendering of bitmap font textures.
  *
- * In future, strings textures might be cached to improve performance, but
- * for now, we just render each glyph on it's own quad
+ * Each glyph is drawn as its own quad. The quads of a string are kept in a
+ * layout cache, so strings that are drawn every frame are only laid out
+ * once. Between beginBatch and endBatch the text is collected and drawn
+ * together when the batch ends.
  */
 class TextRenderer {
 public:
@@ -61,12 +66,101 @@ public:
 
     void renderText(const TextInfo& ti, bool forceColour = false);
 
+    /**
+     * Collects the text rendered until endBatch instead of drawing it
+     */
+    void beginBatch();
+
+    /**
+     * Draws the collected text, one draw for each run of text sharing a font
+     */
+    void endBatch();
+
+    size_t getCachedLayoutCount() const {
+        return layouts.size();
+    }
+
 private:
+    /// Layouts kept before the cache is emptied
+    static constexpr size_t kMaxCachedLayouts = 256;
+
+    struct TextVertex {
+        glm::vec2 position;
+        glm::vec2 texcoord;
+        glm::vec3 colour;
+
+        TextVertex(glm::vec2 _position, glm::vec2 _texcoord, glm::vec3 _colour)
+            : position(_position), texcoord(_texcoord), colour(_colour) {
+        }
+
+        TextVertex() = default;
+
+        static const AttributeList vertex_attributes() {
+            return {
+                {ATRS_Position, 2, sizeof(TextVertex), 0ul},
+                {ATRS_TexCoord, 2, sizeof(TextVertex), 0ul + sizeof(glm::vec2)},
+                {ATRS_Colour, 3, sizeof(TextVertex), 0ul + sizeof(glm::vec2) * 2},
+            };
+        }
+    };
+
+    /**
+     * The quads of a string relative to its screen position, before it's
+     * aligned
+     */
+    struct TextLayout {
+        std::vector<TextVertex> vertices;
+        glm::vec2 extents{};
+        /// Size of the last glyph, used to pad the background
+        glm::vec2 glyphSize{};
+    };
+
+    struct LayoutKey {
+        GameString text;
+        font_t font;
+        float size;
+        int wrapX;
+        glm::u8vec3 colour;
+        bool forceColour;
+
+        bool operator==(const LayoutKey& o) const {
+            return text == o.text && font == o.font && size == o.size &&
+                   wrapX == o.wrapX && colour == o.colour &&
+                   forceColour == o.forceColour;
+        }
+    };
+
+    struct LayoutKeyHash {
+        size_t operator()(const LayoutKey& key) const;
+    };
+
+    std::unordered_map<LayoutKey, TextLayout, LayoutKeyHash> layouts;
+
+    const TextLayout& getLayout(const TextInfo& ti, bool forceColour);
+    TextLayout layoutText(const TextInfo& ti, bool forceColour) const;
+
+    /// Consecutive batched vertices drawn with the same font
+    struct BatchRun {
+        font_t font;
+        size_t start;
+        size_t count;
+    };
+
+    bool batching = false;
+    std::vector<TextVertex> batchVertices;
+    std::vector<BatchRun> batchRuns;
+
+    void flushBatch();
+
+    void draw(const std::vector<TextVertex>& vertices,
+              const glm::vec2& alignment, const BatchRun* runs,
+              size_t runCount);
+
     class FontMetaData {
     public:
         FontMetaData() = default;
         template<size_t N>
-        FontMetaData(const std::string &textureName,
+        FontMetaData(NameId textureName,
                      const std::array<std::uint8_t, N> &glyphWidths,
                      const glm::u32vec2 &textureSize,
                      const glm::u8vec2 &glyphOffset,
@@ -78,7 +172,7 @@ private:
             , monoWidth(monoWidth)
         {
         }
-        std::string textureName;
+        NameId textureName;
         std::vector<std::uint8_t> glyphWidths;
         glm::u32vec2 textureSize;
         glm::u8vec2 glyphOffset;
@@ -89,8 +183,10 @@ private:
 
     GameRenderer& renderer;
     std::unique_ptr<Renderer::ShaderProgram> textShader;
+    Renderer::UniformHandle<glm::mat4> textProj;
+    Renderer::UniformHandle<glm::vec2> textAlignment;
 
-    GeometryBuffer gb;
+    /// Draws from the renderer's stream buffer
     DrawBuffer db;
 };
 #endif
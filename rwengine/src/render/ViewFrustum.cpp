@@ -1,8 +1,19 @@
 #include "render/ViewFrustum.hpp"
 
+#include <algorithm>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#define RW_FRUSTUM_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RW_FRUSTUM_SSE
+#endif
+
 glm::mat4 ViewFrustum::projection() const {
     return glm::perspective(fov / aspectRatio, aspectRatio, near, far);
 }
@@ -23,13 +34,81 @@ void ViewFrustum::update(const glm::mat4 &proj) {
 }
 
 bool ViewFrustum::intersects(glm::vec3 center, float radius) const {
-    float d;
-    bool result = true;
-
     for (const auto &plane : planes) {
-        d = glm::dot(plane.normal, center) + plane.distance;
-        if (d < -radius) result = false;
+        float d = glm::dot(plane.normal, center) + plane.distance;
+        if (d < -radius) {
+            return false;
+        }
     }
 
-    return result;
+    return true;
+}
+
+void ViewFrustum::intersects(SphereBatch &batch) const {
+    batch.mask.assign((batch.size() + 31) / 32, 0u);
+    intersects(batch.x.data(), batch.y.data(), batch.z.data(),
+               batch.radius.data(), batch.size(), batch.mask.data());
+}
+
+void ViewFrustum::intersects(const float *x, const float *y, const float *z,
+                             const float *radius, size_t count,
+                             uint32_t *mask) const {
+    std::fill(mask, mask + (count + 31) / 32, 0u);
+
+    size_t i = 0;
+
+    // Spheres are tested in blocks that evenly divide a mask word, so the
+    // bits of a block never straddle two words
+#if defined(RW_FRUSTUM_AVX)
+    for (; i + 8 <= count; i += 8) {
+        const auto cx = _mm256_loadu_ps(x + i);
+        const auto cy = _mm256_loadu_ps(y + i);
+        const auto cz = _mm256_loadu_ps(z + i);
+        const auto nr = _mm256_sub_ps(_mm256_setzero_ps(),
+                                      _mm256_loadu_ps(radius + i));
+        auto outside = _mm256_setzero_ps();
+        for (const auto &plane : planes) {
+            auto d = _mm256_add_ps(
+                _mm256_mul_ps(cx, _mm256_set1_ps(plane.normal.x)),
+                _mm256_mul_ps(cy, _mm256_set1_ps(plane.normal.y)));
+            d = _mm256_add_ps(
+                d, _mm256_mul_ps(cz, _mm256_set1_ps(plane.normal.z)));
+            d = _mm256_add_ps(d, _mm256_set1_ps(plane.distance));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, nr, _CMP_LT_OQ));
+            if (_mm256_movemask_ps(outside) == 0xFF) {
+                break;
+            }
+        }
+        const auto bits =
+            static_cast<uint32_t>(~_mm256_movemask_ps(outside)) & 0xFFu;
+        mask[i / 32] |= bits << (i % 32);
+    }
+#elif defined(RW_FRUSTUM_SSE)
+    for (; i + 4 <= count; i += 4) {
+        const auto cx = _mm_loadu_ps(x + i);
+        const auto cy = _mm_loadu_ps(y + i);
+        const auto cz = _mm_loadu_ps(z + i);
+        const auto nr = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+        auto outside = _mm_setzero_ps();
+        for (const auto &plane : planes) {
+            auto d = _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane.normal.x)),
+                                _mm_mul_ps(cy, _mm_set1_ps(plane.normal.y)));
+            d = _mm_add_ps(d, _mm_mul_ps(cz, _mm_set1_ps(plane.normal.z)));
+            d = _mm_add_ps(d, _mm_set1_ps(plane.distance));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(d, nr));
+            if (_mm_movemask_ps(outside) == 0xF) {
+                break;
+            }
+        }
+        const auto bits =
+            static_cast<uint32_t>(~_mm_movemask_ps(outside)) & 0xFu;
+        mask[i / 32] |= bits << (i % 32);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        if (intersects(glm::vec3(x[i], y[i], z[i]), radius[i])) {
+            mask[i / 32] |= 1u << (i % 32);
+        }
+    }
 }
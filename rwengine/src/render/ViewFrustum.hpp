@@ -4,6 +4,11 @@
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
 #ifdef RW_WINDOWS
 #include <rw_mingw.hpp>
 #endif
@@ -23,6 +28,56 @@ public:
 
     ViewPlane planes[6]{};
 
+    /**
+     * Spheres stored as separate coordinate arrays for batch testing
+     */
+    struct SphereBatch {
+        std::pmr::vector<float> x;
+        std::pmr::vector<float> y;
+        std::pmr::vector<float> z;
+        std::pmr::vector<float> radius;
+        /// Bit i is set when sphere i intersects the frustum
+        std::pmr::vector<uint32_t> mask;
+
+        /// Batches used for a single tick may allocate from its arena
+        explicit SphereBatch(std::pmr::memory_resource* resource =
+                                 std::pmr::get_default_resource())
+            : x(resource), y(resource), z(resource), radius(resource),
+              mask(resource) {
+        }
+
+        void reserve(size_t count) {
+            x.reserve(count);
+            y.reserve(count);
+            z.reserve(count);
+            radius.reserve(count);
+            mask.reserve((count + 31) / 32);
+        }
+
+        void clear() {
+            x.clear();
+            y.clear();
+            z.clear();
+            radius.clear();
+            mask.clear();
+        }
+
+        void add(const glm::vec3& center, float r) {
+            x.push_back(center.x);
+            y.push_back(center.y);
+            z.push_back(center.z);
+            radius.push_back(r);
+        }
+
+        size_t size() const {
+            return x.size();
+        }
+
+        bool isVisible(size_t i) const {
+            return (mask[i / 32] >> (i % 32)) & 1u;
+        }
+    };
+
     ViewFrustum(float near, float far, float fov, float aspect)
         : near(near), far(far), fov(fov), aspectRatio(aspect) {
     }
@@ -32,6 +87,18 @@ public:
     void update(const glm::mat4& proj);
 
     bool intersects(glm::vec3 center, float radius) const;
+
+    /**
+     * Tests every sphere in the batch and fills in its mask
+     */
+    void intersects(SphereBatch& batch) const;
+
+    /**
+     * Tests count spheres, setting bit i of mask when sphere i intersects.
+     * mask must hold (count + 31) / 32 words.
+     */
+    void intersects(const float* x, const float* y, const float* z,
+                    const float* radius, size_t count, uint32_t* mask) const;
 };
 
 #endif
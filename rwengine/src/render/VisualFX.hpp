@@ -35,6 +35,9 @@ struct ParticleFX final : public VisualFX {
     /** Direction of particle */
     glm::vec3 direction{};
 
+    /** Distance moved per second */
+    glm::vec3 velocity{};
+
     /** Particle orientation modes */
     enum Orientation {
         Free,    /** faces direction using up */
@@ -61,7 +64,7 @@ struct ParticleFX final : public VisualFX {
     /** Render tint colour */
     glm::vec4 colour{1.f, 1.f, 1.f, 1.f};
 
-    /** Constructs a particle */
+    /** Describes a particle to spawn into a ParticleSystem */
     ParticleFX() = default;
     ~ParticleFX() override = default;
 
@@ -27,6 +27,12 @@ WaterRenderer::WaterRenderer(GameRenderer &renderer) {
     renderer.getRenderer().setProgramBlockBinding(maskProg.get(), "SceneData", 1);
 
     renderer.getRenderer().setUniformTexture(waterProg.get(), "data", 1);
+    waterTime =
+        renderer.getRenderer().getUniform<float>(waterProg.get(), "time");
+    waterWaveParams = renderer.getRenderer().getUniform<glm::vec2>(
+        waterProg.get(), "waveParams");
+    waterInverseVP = renderer.getRenderer().getUniform<glm::mat4>(
+        waterProg.get(), "inverseVP");
 
     // Generate grid mesh
     int gridres = 60;
@@ -102,7 +108,8 @@ void WaterRenderer::setDataTexture(GLuint fbBinding, GLuint dataTex) {
 void WaterRenderer::render(GameRenderer &renderer, GameWorld* world) {
     auto& r = renderer.getRenderer();
 
-    auto waterTexPtr = world->data->findSlotTexture("particle", "water_old");
+    auto waterTexPtr =
+        world->data->findSlotTexture("particle"_nid, "water_old"_nid);
     RW_CHECK(waterTexPtr != nullptr, "Water texture is null");
     if (waterTexPtr == nullptr) {
         // Can't render water if we don't have a texture.
@@ -139,12 +146,11 @@ void WaterRenderer::render(GameRenderer &renderer, GameWorld* world) {
     buffers[0] = GL_COLOR_ATTACHMENT0;
     glDrawBuffers(1, buffers);
 
-    r.setUniform(waterProg.get(), "time", world->getGameTime());
-    r.setUniform(waterProg.get(), "waveParams",
-                  glm::vec2(WATER_SCALE, WATER_HEIGHT));
+    r.setUniform(waterTime, world->getGameTime());
+    r.setUniform(waterWaveParams, glm::vec2(WATER_SCALE, WATER_HEIGHT));
     auto ivp =
         glm::inverse(r.getSceneData().projection * r.getSceneData().view);
-    r.setUniform(waterProg.get(), "inverseVP", ivp);
+    r.setUniform(waterInverseVP, ivp);
 
     wdp.count = gridGeom.getCount();
     wdp.textures = {{waterTexPtr->getName(), dataTexture}};
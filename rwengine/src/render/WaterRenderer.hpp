@@ -41,6 +41,9 @@ public:
 
 private:
     std::unique_ptr<Renderer::ShaderProgram> waterProg = nullptr;
+    Renderer::UniformHandle<float> waterTime;
+    Renderer::UniformHandle<glm::vec2> waterWaveParams;
+    Renderer::UniformHandle<glm::mat4> waterInverseVP;
     std::unique_ptr<Renderer::ShaderProgram> maskProg = nullptr;
 
     DrawBuffer maskDraw{};
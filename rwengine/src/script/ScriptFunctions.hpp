@@ -256,7 +256,7 @@ inline void getClosestNode(const ScriptArguments& args, ScriptVec3& coord, ai::N
                            ScriptFloat& xCoord, ScriptFloat& yCoord, ScriptFloat& zCoord) {
     coord = script::getGround(args, coord);
     float closest = 10000.f;
-    std::vector<ai::AIGraphNode*> nodes;
+    std::pmr::vector<ai::AIGraphNode*> nodes(&args.getWorld()->getTickArena());
     args.getWorld()->aigraph.gatherExternalNodesNear(coord, closest, nodes, type);
 
     for (const auto &node : nodes) {
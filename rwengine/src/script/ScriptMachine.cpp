@@ -35,6 +35,9 @@ void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
     }
     if (t.wakeCounter > 0) return;
 
+    // Reused by every instruction, from memory released after the tick
+    SCMParams parameters(&state->world->getTickArena());
+
     while (t.wakeCounter == 0) {
         auto pc = t.programCounter;
         auto opcode = file.read<SCMOpcode>(pc);
@@ -51,7 +54,7 @@ void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
 
         pc += sizeof(SCMOpcode);
 
-        SCMParams parameters;
+        parameters.clear();
 
         bool hasExtraParameters = code.arguments < 0;
         auto requiredParams = std::abs(code.arguments);
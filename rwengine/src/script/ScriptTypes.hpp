@@ -238,7 +238,7 @@ struct SCMOpcodeParameter {
     }
 };
 
-typedef std::vector<SCMOpcodeParameter> SCMParams;
+typedef std::pmr::vector<SCMOpcodeParameter> SCMParams;
 
 class ScriptArguments {
     const SCMParams* parameters;
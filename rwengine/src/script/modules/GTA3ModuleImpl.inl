@@ -1973,10 +1973,18 @@ void opcode_00a6(const ScriptArguments& args, const ScriptVehicle vehicle) {
     @arg coord Coordinates
 */
 void opcode_00a7(const ScriptArguments& args, const ScriptVehicle vehicle, ScriptVec3 coord) {
-    RW_UNIMPLEMENTED_OPCODE(0x00a7);
-    RW_UNUSED(vehicle);
-    RW_UNUSED(coord);
     RW_UNUSED(args);
+
+    // The driver follows the roads and stops at the node closest to coord
+    if (vehicle->getDriver() != nullptr)
+    {
+        // @todo set the right driving style
+        auto controller = vehicle->getDriver()->controller;
+        controller->setGoal(ai::CharacterController::TrafficDriver);
+        controller->setLane(1);
+        controller->setDestination(coord);
+        vehicle->setHandbraking(false);
+    }
 }
 
 /**
@@ -8079,7 +8087,7 @@ void opcode_02f4(const ScriptArguments& args, const ScriptObject object0, const
     auto actor = static_cast<CutsceneObject*>(args.getObject<CutsceneObject>(0));
     CutsceneObject* object = args.getWorld()->createCutsceneObject(id, args.getWorld()->state->currentCutscene->meta.sceneOffset );
 
-    auto headframe = actor->getClump()->findFrame("shead");
+    auto headframe = actor->getClump()->findFrame("shead"_nid);
     for (const auto& atomic : actor->getClump()->getAtomics()) {
     	if (atomic->getFrame().get() == headframe) {
     	    atomic->setFlag(Atomic::ATOMIC_RENDER, false);
@@ -10410,7 +10418,8 @@ void opcode_0394(const ScriptArguments& args, const ScriptInt arg1) {
     }
     else if (args.getWorld()->missionAudio.length() > 0)
     {
-    	args.getWorld()->sound.playSound(args.getWorld()->missionAudio);
+    	args.getWorld()->sound.playSound(
+    	    StringId(args.getWorld()->missionAudio));
     }
 }
 
@@ -11245,7 +11254,7 @@ void opcode_03cf(const ScriptArguments& args, const ScriptString soundID) {
 */
 bool opcode_03d0(const ScriptArguments& args) {
     auto world = args.getWorld();
-    return world->sound.isLoaded(world->missionAudio);
+    return world->sound.isLoaded(StringId(world->missionAudio));
 }
 
 /**
@@ -11256,7 +11265,7 @@ bool opcode_03d0(const ScriptArguments& args) {
 void opcode_03d1(const ScriptArguments& args) {
     auto world = args.getWorld();
     if (world->missionAudio.length() > 0) {
-    	world->sound.playSound(world->missionAudio);
+    	world->sound.playSound(StringId(world->missionAudio));
     }
 }
 
@@ -11267,7 +11276,7 @@ void opcode_03d1(const ScriptArguments& args) {
 */
 bool opcode_03d2(const ScriptArguments& args) {
     auto world = args.getWorld();
-    bool isFinished = ! world->sound.isPlaying(world->missionAudio);
+    bool isFinished = ! world->sound.isPlaying(StringId(world->missionAudio));
 
     if (isFinished) {
     	world->missionAudio = "";
@@ -11346,7 +11355,7 @@ void opcode_03d6(const ScriptArguments& args, const ScriptString gxtEntry) {
 */
 void opcode_03d7(const ScriptArguments& args, ScriptVec3 coord) {
     auto world = args.getWorld();
-    auto& wav = world->sound.getSoundRef(world->missionAudio);
+    auto& wav = world->sound.getSoundRef(StringId(world->missionAudio));
     wav.setPosition(coord);
 }
 
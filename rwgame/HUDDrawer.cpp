@@ -188,23 +188,23 @@ void HUDDrawer::drawPlayerInfo(ai::PlayerController* player, GameWorld* world,
 
     auto item = player->getCharacter()->getActiveItem();
     const auto& weapon = world->data->weaponData[item];
-    std::string itemTextureName = "fist";
+    auto itemTextureName = "fist"_nid;
     if (weapon.modelID > 0) {
         auto model =
             world->data->findModelInfo<SimpleModelInfo>(weapon.modelID);
         if (model != nullptr) {
-            itemTextureName = model->name;
+            itemTextureName = NameId(model->name);
         }
     }
     // Urgh
-    if (itemTextureName == "colt45") {
-        itemTextureName = "pistol";
-    } else if (itemTextureName == "bomb") {
-        itemTextureName = "detonator";
+    if (itemTextureName == "colt45"_nid) {
+        itemTextureName = "pistol"_nid;
+    } else if (itemTextureName == "bomb"_nid) {
+        itemTextureName = "detonator"_nid;
     }
 
     auto itemTexturePtr =
-        render.getData().findSlotTexture("hud", itemTextureName);
+        render.getData().findSlotTexture("hud"_nid, itemTextureName);
     RW_CHECK(itemTexturePtr != nullptr, "Item has 0 texture");
     if (itemTexturePtr != nullptr) {
         RW_CHECK(itemTexturePtr->getName() != 0, "Item has 0 texture");
@@ -254,8 +254,10 @@ void HUDDrawer::drawHUD(ViewCamera& currentView, ai::PlayerController* player,
                         GameWorld* world, GameRenderer& render) {
     if (player && player->getCharacter()) {
         drawMap(currentView, player, world, render);
+        render.text.beginBatch();
         drawPlayerInfo(player, world, render);
         drawScriptTimer(world, render);
+        render.text.endBatch();
     }
 }
 
@@ -269,6 +271,7 @@ void HUDDrawer::drawOnScreenText(GameWorld* world, GameRenderer& renderer) {
 
     auto& alltext = world->state->text.getAllText();
 
+    renderer.text.beginBatch();
     for (auto& l : alltext) {
         for (auto& t : l) {
             ti.size = static_cast<float>(t.size * hudParameters.hudScale);
@@ -308,6 +311,7 @@ void HUDDrawer::drawOnScreenText(GameWorld* world, GameRenderer& renderer) {
             renderer.text.renderText(ti);
         }
     }
+    renderer.text.endBatch();
 }
 
 void HUDDrawer::applyHUDScale(float scale) {
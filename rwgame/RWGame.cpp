@@ -26,6 +26,7 @@
 #include <objects/VehicleObject.hpp>
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #include <iomanip>
@@ -56,10 +57,13 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
     : GameBase(log, args)
     , data(&log, config.gamedataPath())
     , renderer(&log, &data)
-    , imgui(*this) {
+    , imgui(*this)
+    , jobs(static_cast<unsigned int>(std::max(config.workerThreads(), 0))) {
     RW_PROFILE_THREAD("Main");
     RW_TIMELINE_ENTER("Startup", MP_YELLOW);
 
+    renderer.frameStats = &frameStats;
+
     auto loadTimeStart = std::chrono::steady_clock::now();
     bool newgame = false;
     bool test = false;
@@ -70,6 +74,7 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
         test = args->test;
         startSave = args->loadGamePath;
         benchFile = args->benchmarkPath;
+        tracePath = args->tracePath;
     }
 
     imgui.init();
@@ -111,6 +116,7 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
         oss << "radar" << std::setw(2) << std::setfill('0') << m << ".txd";
         data.loadTXD(oss.str());
     }
+    getRenderer().map.buildAtlas();
 
     stateManager.enter<LoadingState>(this, [=]() {
         if (benchFile.has_value()) {
@@ -137,6 +143,22 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
 
 RWGame::~RWGame() {
     log.info("Game", "Beginning cleanup");
+    writeTrace();
+}
+
+void RWGame::writeTrace() {
+    if (!tracePath) {
+        return;
+    }
+#ifdef RW_TRACE_PROFILER
+    if (RW_PROFILE_WRITE_TRACE(*tracePath)) {
+        log.info("Game", "Wrote profile trace to " + *tracePath);
+    } else {
+        log.error("Game", "Failed to write profile trace to " + *tracePath);
+    }
+#else
+    log.warning("Game", "Built without ENABLE_TRACE_PROFILING, no trace");
+#endif
 }
 
 void RWGame::newGame() {
@@ -144,8 +166,9 @@ void RWGame::newGame() {
     state = GameState();
 
     // Destroy the current world and start over
-    world = std::make_unique<GameWorld>(&log, &data);
+    world = std::make_unique<GameWorld>(&log, &data, config.physicsThreads());
     world->dynamicsWorld->setDebugDrawer(&debug);
+    world->jobSystem = &jobs;
 
     // Associate the new world with the new state and vice versa
     state.world = world.get();
@@ -425,7 +448,11 @@ int RWGame::run() {
         RW_PROFILE_FRAME_BOUNDARY();
         RW_PROFILE_SCOPE("Main Loop");
 
-        running = updateInput();
+        {
+            FrameStats::ScopedTimer timer(&frameStats,
+                                          FrameStats::Stage::Input);
+            running = updateInput();
+        }
 
         auto currentFrame = chrono::steady_clock::now();
         auto frameTime =
@@ -443,12 +470,22 @@ int RWGame::run() {
             accumulatedTime = tickWorld(deltaTime, accumulatedTime);
         }
 
-        render(1, frameTime);
+        {
+            FrameStats::ScopedTimer timer(&frameStats,
+                                          FrameStats::Stage::Render);
+            render(1, frameTime);
+        }
 
-        getWindow().swap();
+        {
+            FrameStats::ScopedTimer timer(&frameStats,
+                                          FrameStats::Stage::Swap);
+            getWindow().swap();
+        }
 
         // Make sure the topmost state is the correct state
         stateManager.updateStack();
+
+        frameStats.endFrame();
     }
 
     stateManager.clear();
@@ -466,8 +503,12 @@ float RWGame::tickWorld(const float deltaTime, float accumulatedTime) {
             break;
         }
 
+        FrameStats::ScopedTimer timer(&frameStats, FrameStats::Stage::Tick);
+
         {
             RW_PROFILE_SCOPEC("stepSimulation", MP_DARKORANGE1);
+            FrameStats::ScopedTimer physicsTimer(&frameStats,
+                                                 FrameStats::Stage::Physics);
             world->dynamicsWorld->stepSimulation(
                     deltaTimeWithTimeScale, kMaxPhysicsSubSteps, deltaTime);
         }
@@ -579,11 +620,24 @@ void RWGame::tick(float dt) {
             }
         }
 
-        tickObjects(dt);
+        if (state.playerObject) {
+            world->aiScheduler.beginTick(currentCam.position,
+                                         currentCam.frustum);
+        } else {
+            world->aiScheduler.reset();
+        }
+
+        {
+            FrameStats::ScopedTimer timer(&frameStats,
+                                          FrameStats::Stage::Objects);
+            tickObjects(dt);
+        }
 
         state.text.tick(dt);
 
         if (vm) {
+            FrameStats::ScopedTimer timer(&frameStats,
+                                          FrameStats::Stage::Script);
             try {
                 vm->execute(dt);
             } catch (SCMException& ex) {
@@ -599,6 +653,7 @@ void RWGame::tick(float dt) {
                                       currentCam.getView());
             // Use the current camera position to spawn pedestrians.
             world->cleanupTraffic(currentCam);
+            world->updatePhysicsLOD(currentCam.position);
             // Only create new traffic outside cutscenes
             if (!state.currentCutscene) {
                 world->createTraffic(currentCam);
@@ -609,14 +664,12 @@ void RWGame::tick(float dt) {
 
 void RWGame::tickObjects(float dt) const {
     RW_PROFILE_SCOPEC(__func__, MP_MAGENTA1);
-    world->updateEffects();
+    world->updateEffects(dt);
 
     {
         RW_PROFILE_SCOPEC("allObjects", MP_HOTPINK1);
         RW_PROFILE_COUNTER_SET("tickObjects/allObjects", world->allObjects.size());
-        for (auto &object : world->allObjects) {
-            object->tick(dt);
-        }
+        world->tickObjects(dt);
     }
 
     {
@@ -634,6 +687,7 @@ void RWGame::tickObjects(float dt) const {
     }
 
     world->destroyQueuedObjects();
+    world->instanceTree.rebuild();
 }
 
 void RWGame::render(float alpha, float time) {
@@ -834,6 +888,9 @@ void RWGame::globalKeyEvent(const SDL_Event& event) {
         case SDLK_F4:
             toggle_debug(DebugViewMode::Objects);
             break;
+        case SDLK_F12:
+            writeTrace();
+            break;
         default:
             break;
     }
@@ -8,6 +8,8 @@
 #include "StateManager.hpp"
 #include "game.hpp"
 
+#include <core/FrameStats.hpp>
+#include <core/JobSystem.hpp>
 #include <engine/GameData.hpp>
 #include <engine/GameState.hpp>
 #include <engine/GameWorld.hpp>
@@ -38,6 +40,8 @@ private:
     DebugDraw debug;
     GameState state;
     HUDDrawer hudDrawer{};
+    JobSystem jobs;
+    FrameStats frameStats;
 
     std::unique_ptr<GameWorld> world;
 
@@ -55,6 +59,9 @@ private:
 
     std::string cheatInputWindow = std::string(32, ' ');
 
+    /// Where the profile trace is written, on exit or on F12
+    std::optional<std::string> tracePath;
+
 public:
     RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args);
     ~RWGame() override;
@@ -98,6 +105,10 @@ public:
         return debugview_;
     }
 
+    const FrameStats& getFrameStats() const {
+        return frameStats;
+    }
+
     bool hitWorldRay(glm::vec3& hit, glm::vec3& normal,
                      GameObject** object = nullptr);
 
@@ -131,6 +142,8 @@ private:
     void renderDebugView();
 
     void tickObjects(float dt) const;
+
+    void writeTrace();
 };
 
 #endif
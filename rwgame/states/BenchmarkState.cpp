@@ -67,6 +67,14 @@ void BenchmarkState::exit() {
               << "Avg frametime: " << std::setprecision(3)
               << (duration / frameCounter) << " (" << (frameCounter / duration)
               << " fps)" << '\n';
+
+    if (profiledFrames > 0) {
+        std::cout << "Avg GPU time over " << profiledFrames << " frames:\n";
+        for (const auto& [title, time] : gpuTimes) {
+            std::cout << " " << title << ": " << (time / profiledFrames)
+                      << " ms\n";
+        }
+    }
 }
 
 void BenchmarkState::tick(float dt) {
@@ -95,6 +103,18 @@ void BenchmarkState::tick(float dt) {
 void BenchmarkState::draw(GameRenderer& r) {
     frameCounter++;
     State::draw(r);
+
+    const auto& history = r.getRenderer().getProfileHistory();
+    if (!history.empty() && history.back().frame > lastProfiledFrame) {
+        lastProfiledFrame = history.back().frame;
+        profiledFrames++;
+        for (const auto& group : history.back().groups) {
+            if (group.depth == 0) {
+                gpuTimes[group.title] +=
+                    static_cast<double>(group.info.duration) / 1000000.0;
+            }
+        }
+    }
 }
 
 void BenchmarkState::handleEvent(const SDL_Event& e) {
@@ -8,6 +8,8 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/vec3.hpp>
 
+#include <cstdint>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -27,6 +29,11 @@ class BenchmarkState final : public State {
     float duration{0.f};
     uint32_t frameCounter{0};
 
+    // Total GPU time of each top level debug group
+    std::map<std::string, double> gpuTimes;
+    uint64_t lastProfiledFrame{0};
+    uint32_t profiledFrames{0};
+
 public:
     BenchmarkState(RWGame* game, const std::string& benchfile);
 
@@ -104,6 +104,104 @@ void DebugState::drawDebugMenu() {
         ImGui::EndMenu();
     }
 
+    if (ImGui::BeginMenu("Performance")) {
+        ImGui::MenuItem("Show Performance", nullptr, &_showPerformance);
+        ImGui::EndMenu();
+    }
+
+    ImGui::End();
+}
+
+void DebugState::drawPerformanceWindow() {
+    const auto& stats = game->getFrameStats();
+    const auto world = getWorld();
+    auto& renderer = game->getRenderer();
+
+    ImGui::SetNextWindowSize({360.f, 0.f}, ImGuiCond_FirstUseEver);
+    ImGui::Begin("Performance", &_showPerformance);
+
+    const auto offset = static_cast<int>(stats.getHistoryOffset());
+    const auto count = static_cast<int>(FrameStats::kHistorySize);
+    const auto frameTime = static_cast<double>(stats.getAverageFrameTime());
+    ImGui::Text("Frame %.2f ms (%.1f FPS)", frameTime,
+                frameTime > 0.0 ? 1000.0 / frameTime : 0.0);
+    ImGui::PlotLines("Frame", stats.getFrameTimes().data(), count, offset,
+                     nullptr, 0.f, 50.f, {0.f, 60.f});
+    ImGui::PlotLines("Tick",
+                     stats.getStageTimes(FrameStats::Stage::Tick).data(),
+                     count, offset, nullptr, 0.f, 50.f, {0.f, 60.f});
+
+    if (ImGui::CollapsingHeader("Stages", ImGuiTreeNodeFlags_DefaultOpen)) {
+        const auto last =
+            (stats.getHistoryOffset() + FrameStats::kHistorySize - 1) %
+            FrameStats::kHistorySize;
+        for (auto i = 0u; i < FrameStats::kStageCount; ++i) {
+            const auto stage = static_cast<FrameStats::Stage>(i);
+            ImGui::Text("%*s%-14s %6.2f ms  avg %6.2f ms",
+                        FrameStats::getStageDepth(stage) * 2, "",
+                        FrameStats::getStageName(stage),
+                        static_cast<double>(stats.getStageTimes(stage)[last]),
+                        static_cast<double>(stats.getAverage(stage)));
+        }
+    }
+
+    if (ImGui::CollapsingHeader("World", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Text("Vehicles %zu  Peds %zu",
+                    world->vehiclePool.objects.size(),
+                    world->pedestrianPool.objects.size());
+        ImGui::Text("Instances %zu  Effects %zu  Particles %zu",
+                    world->instancePool.objects.size(), world->effects.size(),
+                    world->particles.size());
+    }
+
+    if (ImGui::CollapsingHeader("Rendering", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Text("Render list %zu  Culled %zu  Draws %i",
+                    renderer.getRenderListSize(), renderer.getCulledCount(),
+                    renderer.getRenderer().getDrawCount());
+        constexpr double kMiB = 1024.0 * 1024.0;
+        const auto& data = *world->data;
+        ImGui::Text("Textures %.1f MiB  Geometry %.1f MiB",
+                    static_cast<double>(data.getTextureMemory()) / kMiB,
+                    static_cast<double>(data.getGeometryMemory()) / kMiB);
+    }
+
+    if (ImGui::CollapsingHeader("Arenas", ImGuiTreeNodeFlags_DefaultOpen)) {
+        constexpr double kKiB = 1024.0;
+        const auto showArena = [&](const char* name, const FrameArena& arena) {
+            ImGui::Text("%-5s %8.1f KiB  Peak %8.1f KiB  Overflows %zu", name,
+                        static_cast<double>(arena.getCapacity()) / kKiB,
+                        static_cast<double>(arena.getHighWaterMark()) / kKiB,
+                        arena.getLastOverflowCount());
+        };
+        showArena("Frame", renderer.getRenderer().getFrameArena());
+        showArena("Tick", world->getTickArena());
+    }
+
+    const auto& profiles = renderer.getRenderer().getProfileHistory();
+    if (!profiles.empty() &&
+        ImGui::CollapsingHeader("GPU", ImGuiTreeNodeFlags_DefaultOpen)) {
+        constexpr double kNsPerMs = 1000.0 * 1000.0;
+        // Groups of the latest resolved frame, averaged over the history
+        for (const auto& group : profiles.back().groups) {
+            double total = 0.0;
+            size_t samples = 0;
+            for (const auto& profile : profiles) {
+                for (const auto& other : profile.groups) {
+                    if (other.depth == group.depth &&
+                        other.title == group.title) {
+                        total += static_cast<double>(other.info.duration);
+                        samples++;
+                        break;
+                    }
+                }
+            }
+            ImGui::Text("%*s%-14s %6.2f ms  avg %6.2f ms", group.depth * 2, "",
+                        group.title.c_str(),
+                        static_cast<double>(group.info.duration) / kNsPerMs,
+                        total / static_cast<double>(samples) / kNsPerMs);
+        }
+    }
+
     ImGui::End();
 }
 
@@ -394,6 +492,10 @@ void DebugState::draw(GameRenderer& r) {
 
     drawDebugMenu();
 
+    if (_showPerformance) {
+        drawPerformanceWindow();
+    }
+
     State::draw(r);
 }
 
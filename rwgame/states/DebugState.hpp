@@ -17,6 +17,7 @@ class DebugState final : public State {
     bool _freeLook = false;
     bool _sonicMode = false;
     bool _invertedY;
+    bool _showPerformance = false;
 
     void drawDebugMenu();
     void drawMapMenu();
@@ -25,6 +26,7 @@ class DebugState final : public State {
     void drawWeaponMenu();
     void drawWeatherMenu();
     void drawMissionsMenu();
+    void drawPerformanceWindow();
 
 public:
     DebugState(RWGame* game, const glm::vec3& vp = {},
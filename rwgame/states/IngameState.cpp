@@ -253,12 +253,12 @@ void IngameState::tick(float dt) {
             if (player->getCharacter()->getCurrentVehicle()) {
                 player->exitVehicle();
             } else if (!player->isCurrentActivity(
-                           ai::Activities::EnterVehicle::ActivityName)) {
+                           ai::Activities::EnterVehicle::ActivityId)) {
                 player->enterNearestVehicle();
             }
         } else if (glm::length2(movement) > 0.001f) {
             if (player->isCurrentActivity(
-                    ai::Activities::EnterVehicle::ActivityName)) {
+                    ai::Activities::EnterVehicle::ActivityId)) {
                 // Give up entering a vehicle if we're alreadying doing so
                 player->skipActivity();
             }
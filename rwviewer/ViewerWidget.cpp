@@ -144,6 +144,8 @@ void ViewerWidget::paintGL() {
 
     RW_CHECK(_renderer != nullptr, "GameRenderer is null");
     auto& r = *_renderer;
+    // Each paint is a frame, release the memory of the previous one
+    r.getRenderer().swap();
     r.getRenderer().invalidate();
     r.setViewport(width() * devicePixelRatio(), height() * devicePixelRatio());
 
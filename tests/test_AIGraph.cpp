@@ -0,0 +1,71 @@
+#include <boost/test/unit_test.hpp>
+#include <ai/AIGraph.hpp>
+#include <ai/AIGraphNode.hpp>
+#include <data/PathData.hpp>
+
+namespace {
+
+size_t countConnections(const ai::AIGraph& graph) {
+    size_t connections = 0;
+    for (const auto& node : graph.nodes) {
+        connections += node->connections.size();
+    }
+    return connections;
+}
+
+PathData makePath(const glm::vec3& from, const glm::vec3& to) {
+    return {PathData::PATH_PED,
+            0,
+            "",
+            {
+                {PathNode::EXTERNAL, 1, from, 1.f, 0, 0},
+                {PathNode::INTERNAL, 2, (from + to) * 0.5f, 1.f, 0, 0},
+                {PathNode::EXTERNAL, -1, to, 1.f, 0, 0},
+            }};
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(AIGraphTests)
+
+BOOST_AUTO_TEST_CASE(test_external_nodes_merged) {
+    ai::AIGraph graph;
+    const glm::quat identity{1.0f, 0.0f, 0.0f, 0.0f};
+
+    // Three paths meeting at (10, 0, 0), one across a cell boundary
+    auto a = makePath({0.f, 0.f, 0.f}, {10.f, 0.f, 0.f});
+    auto b = makePath({10.5f, 0.f, 0.f}, {20.f, 0.f, 0.f});
+    auto c = makePath({9.9f, -0.2f, 0.f}, {10.f, -10.f, 0.f});
+    // Too far from the others to join them
+    auto d = makePath({11.5f, 0.f, 0.f}, {11.5f, 10.f, 0.f});
+    graph.createPathNodes(glm::vec3(), identity, a);
+    graph.createPathNodes(glm::vec3(), identity, b);
+    graph.createPathNodes(glm::vec3(), identity, c);
+    graph.createPathNodes(glm::vec3(), identity, d);
+
+    BOOST_CHECK_EQUAL(graph.nodes.size(), 10u);
+    BOOST_CHECK_EQUAL(graph.externalNodes.size(), 6u);
+    BOOST_CHECK_EQUAL(countConnections(graph), 16u);
+
+    // The hub has the internal node of each of the three paths
+    BOOST_CHECK_EQUAL(graph.externalNodes[1]->connections.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(test_oldest_external_node_joined) {
+    ai::AIGraph graph;
+    const glm::quat identity{1.0f, 0.0f, 0.0f, 0.0f};
+
+    auto a = makePath({0.f, 0.f, 0.f}, {0.f, 10.f, 0.f});
+    auto b = makePath({1.2f, 0.f, 0.f}, {1.2f, -10.f, 0.f});
+    // In range of both, but nearer to the second
+    auto c = makePath({0.7f, 0.f, 0.f}, {10.f, 0.f, 0.f});
+    graph.createPathNodes(glm::vec3(), identity, a);
+    graph.createPathNodes(glm::vec3(), identity, b);
+    graph.createPathNodes(glm::vec3(), identity, c);
+
+    BOOST_CHECK_EQUAL(graph.externalNodes.size(), 5u);
+    BOOST_CHECK_EQUAL(graph.externalNodes[0]->connections.size(), 2u);
+    BOOST_CHECK_EQUAL(graph.externalNodes[2]->connections.size(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,81 @@
+#include <boost/test/unit_test.hpp>
+#include <ai/AIScheduler.hpp>
+#include <render/ViewCamera.hpp>
+
+namespace {
+
+struct SchedulerFixture {
+    // Looking along +X from the origin
+    ViewCamera camera;
+    ai::AIScheduler scheduler;
+
+    SchedulerFixture() {
+        camera.frustum.update(camera.frustum.projection() * camera.getView());
+        scheduler.beginTick(camera.position, camera.frustum);
+    }
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(AISchedulerTests)
+
+BOOST_AUTO_TEST_CASE(test_no_focus_updates_every_tick) {
+    ai::AIScheduler scheduler;
+    BOOST_CHECK_EQUAL(scheduler.getInterval({1000.f, 0.f, 0.f}), 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_intervals, SchedulerFixture) {
+    BOOST_CHECK_EQUAL(scheduler.getInterval({10.f, 0.f, 0.f}), 1u);
+    BOOST_CHECK_EQUAL(scheduler.getInterval({80.f, 0.f, 0.f}), 2u);
+    BOOST_CHECK_EQUAL(scheduler.getInterval({-40.f, 0.f, 0.f}), 4u);
+    BOOST_CHECK_EQUAL(scheduler.getInterval({-80.f, 0.f, 0.f}), 8u);
+    BOOST_CHECK_EQUAL(scheduler.getInterval({-200.f, 0.f, 0.f}),
+                      ai::AIScheduler::kDormant);
+
+    scheduler.reset();
+    BOOST_CHECK_EQUAL(scheduler.getInterval({-200.f, 0.f, 0.f}), 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_accumulated_time, SchedulerFixture) {
+    ai::AIScheduler::Slot slot;
+    const glm::vec3 position{-80.f, 0.f, 0.f};
+
+    int updates = 0;
+    float updatedTime = 0.f;
+    for (auto i = 0; i < 16; ++i) {
+        float dt = 0.f;
+        if (scheduler.schedule(slot, 3u, position, 0.25f, dt)) {
+            ++updates;
+            updatedTime += dt;
+        }
+        scheduler.beginTick(camera.position, camera.frustum);
+    }
+
+    BOOST_CHECK_EQUAL(updates, 2);
+    BOOST_CHECK_CLOSE(updatedTime + slot.pendingTime, 4.f, 0.01f);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_work_is_spread, SchedulerFixture) {
+    const glm::vec3 position{-80.f, 0.f, 0.f};
+
+    // Eight controllers on the same interval update on different ticks
+    ai::AIScheduler::Slot slots[8];
+    for (auto tick = 0; tick < 8; ++tick) {
+        int updates = 0;
+        for (auto id = 0u; id < 8u; ++id) {
+            float dt;
+            updates += scheduler.schedule(slots[id], id, position, 0.1f, dt);
+        }
+        BOOST_CHECK_EQUAL(updates, 1);
+        scheduler.beginTick(camera.position, camera.frustum);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_dormant_drops_time, SchedulerFixture) {
+    ai::AIScheduler::Slot slot;
+    float dt = 0.f;
+    BOOST_CHECK(!scheduler.schedule(slot, 0u, {-200.f, 0.f, 0.f}, 1.f, dt));
+    BOOST_CHECK_EQUAL(slot.pendingTime, 0.f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
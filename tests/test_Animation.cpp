@@ -19,7 +19,7 @@ BOOST_AUTO_TEST_CASE(test_matrix) {
 
         animation->duration = 1.f;
         animation->bones.emplace(
-            "player", AnimationBone(
+            "player"_nid, AnimationBone(
                           "player", 0, 0, 1.0f, AnimationBone::RT0,
                           std::vector<AnimationKeyframe>{
                               {glm::quat{1.0f, 0.0f, 0.0f, 0.0f},
@@ -32,7 +32,7 @@ BOOST_AUTO_TEST_CASE(test_matrix) {
 
         animator.tick(0.0f);
 
-        const auto& root = test_model->findFrame("player");
+        const auto& root = test_model->findFrame("player"_nid);
 
         BOOST_CHECK(glm::vec3(root->getTransform()[3]) ==
                     glm::vec3(0.f, 0.f, 0.f));
@@ -17,7 +17,7 @@ BOOST_FIXTURE_TEST_CASE(testBufferIsPlaying, F) {
 
     manager.loadSound("A1_a", audioPath.string());
 
-    auto& sound = manager.getSoundRef("A1_a");
+    auto& sound = manager.getSoundRef("A1_a"_sid);
     BOOST_REQUIRE(sound.source->decodedFrames > 0);
 
     BOOST_REQUIRE(sound.isPlaying() == false);
@@ -41,7 +41,7 @@ BOOST_FIXTURE_TEST_CASE(testDecodingFramesOfMusic, F) {
 
     manager.loadSound("A1_a", audioPath.string());
 
-    auto& sound = manager.getSoundRef("A1_a");
+    auto& sound = manager.getSoundRef("A1_a"_sid);
     BOOST_REQUIRE(sound.source->decodedFrames > 0);
 }
 
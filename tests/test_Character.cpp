@@ -1,5 +1,8 @@
+#include <ai/AIGraph.hpp>
+#include <ai/AIGraphNode.hpp>
 #include <ai/DefaultAIController.hpp>
 #include <boost/test/unit_test.hpp>
+#include <data/PathData.hpp>
 #include <engine/Animator.hpp>
 #include <objects/CharacterObject.hpp>
 #include <objects/VehicleObject.hpp>
@@ -164,4 +167,72 @@ BOOST_AUTO_TEST_CASE(test_cycle_animating) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_drive_to_destination) {
+    auto world = Global::get().e;
+
+    /*
+     * d - e - f
+     * |       |
+     * a - b - c
+     */
+    const glm::vec3 origin{1000.f, 1000.f, 0.f};
+    const glm::quat identity{1.0f, 0.0f, 0.0f, 0.0f};
+    PathData bottom{PathData::PATH_CAR,
+                    0,
+                    "",
+                    {{PathNode::EXTERNAL, 1, {0.f, 0.f, 0.f}, 1.f, 1, 1},
+                     {PathNode::INTERNAL, 2, {20.f, 0.f, 0.f}, 1.f, 1, 1},
+                     {PathNode::EXTERNAL, -1, {40.f, 0.f, 0.f}, 1.f, 1, 1}}};
+    PathData top{PathData::PATH_CAR,
+                 0,
+                 "",
+                 {{PathNode::EXTERNAL, 1, {0.f, 0.f, 0.f}, 1.f, 1, 1},
+                  {PathNode::INTERNAL, 2, {0.f, 20.f, 0.f}, 1.f, 1, 1},
+                  {PathNode::INTERNAL, 3, {20.f, 20.f, 0.f}, 1.f, 1, 1},
+                  {PathNode::INTERNAL, 4, {40.f, 20.f, 0.f}, 1.f, 1, 1},
+                  {PathNode::EXTERNAL, -1, {40.f, 0.f, 0.f}, 1.f, 1, 1}}};
+    const auto first = world->aigraph.nodes.size();
+    world->aigraph.createPathNodes(origin, identity, bottom);
+    world->aigraph.createPathNodes(origin, identity, top);
+    BOOST_REQUIRE_EQUAL(world->aigraph.nodes.size(), first + 6);
+    auto a = world->aigraph.nodes[first].get();
+    auto d = world->aigraph.nodes[first + 3].get();
+    auto e = world->aigraph.nodes[first + 4].get();
+
+    VehicleObject* vehicle = world->createVehicle(90u, a->position, identity);
+    BOOST_REQUIRE(vehicle != nullptr);
+    auto character = world->createPedestrian(1, a->position);
+    BOOST_REQUIRE(character != nullptr);
+    character->setCurrentVehicle(vehicle, 0);
+    vehicle->setOccupant(0, character);
+
+    auto controller = character->controller;
+    controller->setGoal(ai::CharacterController::TrafficDriver);
+    controller->setLane(1);
+    controller->targetNode = a;
+    controller->setDestination(e->position);
+
+    // The route to e leads through d, not b
+    character->tick(1.f / 60.f);
+    BOOST_CHECK_EQUAL(controller->targetNode, d);
+    BOOST_CHECK_LT(glm::distance(vehicle->getPathTarget(), d->position), 5.f);
+
+    vehicle->setPosition(d->position);
+    character->tick(1.f / 60.f);
+    character->tick(1.f / 60.f);
+    BOOST_CHECK_EQUAL(controller->targetNode, e);
+    BOOST_CHECK_LT(glm::distance(vehicle->getPathTarget(), e->position), 5.f);
+
+    // Arriving ends the drive
+    vehicle->setPosition(e->position);
+    character->tick(1.f / 60.f);
+    character->tick(1.f / 60.f);
+    BOOST_CHECK(!controller->hasDestination());
+    BOOST_CHECK_EQUAL(controller->getGoal(), ai::CharacterController::None);
+    BOOST_CHECK(vehicle->getHandbraking());
+
+    world->destroyObject(character);
+    world->destroyObject(vehicle);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -43,17 +43,17 @@ BOOST_AUTO_TEST_CASE(test_weapon_dat) {
 
 BOOST_AUTO_TEST_CASE(test_dynamic_dat_loader) {
     GenericDATLoader l;
-    std::unordered_map<std::string, DynamicObjectData> dynamicObjects;
+    std::unordered_map<NameId, DynamicObjectData> dynamicObjects;
 
     l.loadDynamicObjects(Global::get().getGamePath() + "/data/object.dat",
                          dynamicObjects);
 
     BOOST_ASSERT(!dynamicObjects.empty());
 
-    BOOST_ASSERT(dynamicObjects.find("wastebin") != dynamicObjects.end());
-    BOOST_ASSERT(dynamicObjects.find("lamppost1") != dynamicObjects.end());
+    BOOST_ASSERT(dynamicObjects.find("wastebin"_nid) != dynamicObjects.end());
+    BOOST_ASSERT(dynamicObjects.find("lamppost1"_nid) != dynamicObjects.end());
 
-    auto lamp = dynamicObjects.at("lamppost1");
+    auto lamp = dynamicObjects.at("lamppost1"_nid);
 
     BOOST_CHECK_EQUAL(lamp.mass, 600.0);
     BOOST_CHECK_EQUAL(lamp.turnMass, 4000.0);
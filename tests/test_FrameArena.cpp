@@ -0,0 +1,85 @@
+#include <boost/test/unit_test.hpp>
+#include <core/FrameArena.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+/// Counts the allocations that reach the heap
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t live = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        allocations++;
+        live++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        live--;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(FrameArenaTests)
+
+BOOST_AUTO_TEST_CASE(test_allocations_aligned) {
+    FrameArena arena(256);
+    BOOST_CHECK(arena.allocate(1, 1) != nullptr);
+    for (size_t alignment : {2u, 8u, 16u, 64u}) {
+        auto p = arena.allocate(3, alignment);
+        BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(p) % alignment, 0u);
+    }
+    // Larger than the block
+    auto p = arena.allocate(1000, 128);
+    BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(p) % 128, 0u);
+    BOOST_CHECK_EQUAL(arena.getOverflowCount(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_reset_grows_to_high_water_mark) {
+    CountingResource heap;
+    {
+        FrameArena arena(256, &heap);
+        BOOST_CHECK_EQUAL(heap.allocations, 1u);
+
+        for (auto frame = 0; frame < 3; ++frame) {
+            std::pmr::vector<int> values(&arena);
+            for (auto i = 0; i < 1000; ++i) {
+                values.push_back(i);
+            }
+            BOOST_CHECK_EQUAL(values[999], 999);
+            values = {};
+            arena.reset();
+        }
+
+        BOOST_CHECK_GE(arena.getHighWaterMark(), 1000 * sizeof(int));
+        BOOST_CHECK_GE(arena.getCapacity(), arena.getHighWaterMark());
+        BOOST_CHECK_EQUAL(arena.getLastOverflowCount(), 0u);
+        BOOST_CHECK_EQUAL(arena.getUsed(), 0u);
+
+        // The frames after the first are served from the grown block
+        const auto allocations = heap.allocations;
+        {
+            std::pmr::vector<int> values(&arena);
+            for (auto i = 0; i < 1000; ++i) {
+                values.push_back(i);
+            }
+        }
+        arena.reset();
+        BOOST_CHECK_EQUAL(heap.allocations, allocations);
+    }
+    BOOST_CHECK_EQUAL(heap.live, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,45 @@
+#include <boost/test/unit_test.hpp>
+#include <core/FrameStats.hpp>
+
+BOOST_AUTO_TEST_SUITE(FrameStatsTests)
+
+BOOST_AUTO_TEST_CASE(test_stage_times_summed_per_frame) {
+    FrameStats stats;
+    stats.addTime(FrameStats::Stage::Physics, 1.f);
+    stats.addTime(FrameStats::Stage::Physics, 2.f);
+    stats.endFrame();
+
+    const auto& physics = stats.getStageTimes(FrameStats::Stage::Physics);
+    BOOST_CHECK_EQUAL(stats.getHistoryOffset(), 1u);
+    BOOST_CHECK_EQUAL(physics[0], 3.f);
+
+    stats.endFrame();
+    BOOST_CHECK_EQUAL(physics[1], 0.f);
+    BOOST_CHECK_CLOSE(stats.getAverage(FrameStats::Stage::Physics), 1.5f,
+                      0.01f);
+}
+
+BOOST_AUTO_TEST_CASE(test_history_wraps) {
+    FrameStats stats;
+    for (auto i = 0u; i < FrameStats::kHistorySize + 2; ++i) {
+        stats.addTime(FrameStats::Stage::Draw, static_cast<float>(i));
+        stats.endFrame();
+    }
+
+    const auto& draw = stats.getStageTimes(FrameStats::Stage::Draw);
+    BOOST_CHECK_EQUAL(stats.getHistoryOffset(), 2u);
+    BOOST_CHECK_EQUAL(draw[0], static_cast<float>(FrameStats::kHistorySize));
+    BOOST_CHECK_EQUAL(draw[2], 2.f);
+}
+
+BOOST_AUTO_TEST_CASE(test_scoped_timer) {
+    FrameStats stats;
+    {
+        FrameStats::ScopedTimer timer(&stats, FrameStats::Stage::Script);
+        FrameStats::ScopedTimer ignored(nullptr, FrameStats::Stage::Script);
+    }
+    stats.endFrame();
+    BOOST_CHECK_GE(stats.getStageTimes(FrameStats::Stage::Script)[0], 0.f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
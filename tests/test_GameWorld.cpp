@@ -1,6 +1,8 @@
 #include <boost/test/unit_test.hpp>
 #include <engine/GameData.hpp>
 #include <engine/GameWorld.hpp>
+#include <engine/TickCommands.hpp>
+#include <objects/CharacterObject.hpp>
 #include <objects/InstanceObject.hpp>
 #include "test_Globals.hpp"
 
@@ -67,4 +69,30 @@ BOOST_AUTO_TEST_CASE(test_offsetgametime) {
     BOOST_CHECK_EQUAL(25, gw.getMinute());
 }
 
+BOOST_AUTO_TEST_CASE(test_tick_commands_defer_destruction) {
+    auto& gw = *Global::get().e;
+
+    auto character = gw.createPedestrian(1, {100.f, 100.f, 50.f});
+    BOOST_REQUIRE(character != nullptr);
+    const auto id = character->getGameObjectID();
+
+    TickCommands commands;
+    {
+        TickCommands::Scope scope(commands);
+        BOOST_CHECK_EQUAL(TickCommands::current(), &commands);
+        gw.destroyObjectQueued(character);
+    }
+    BOOST_CHECK(TickCommands::current() == nullptr);
+    BOOST_CHECK(!commands.empty());
+
+    // Nothing was queued while the commands were recording
+    gw.destroyQueuedObjects();
+    BOOST_CHECK(gw.pedestrianPool.find(id) != nullptr);
+
+    commands.apply(gw);
+    BOOST_CHECK(commands.empty());
+    gw.destroyQueuedObjects();
+    BOOST_CHECK(gw.pedestrianPool.find(id) == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,102 @@
+#include <boost/test/unit_test.hpp>
+#include <dynamics/GroundHeightField.hpp>
+#ifdef _MSC_VER
+#pragma warning(disable : 4305 5033)
+#endif
+#include <btBulletDynamicsCommon.h>
+#ifdef _MSC_VER
+#pragma warning(default : 4305 5033)
+#endif
+
+#include <memory>
+
+namespace {
+
+struct GroundFixture {
+    btDefaultCollisionConfiguration collisionConfig;
+    btCollisionDispatcher collisionDispatcher;
+    btDbvtBroadphase broadphase;
+    btSequentialImpulseConstraintSolver solver;
+    btDiscreteDynamicsWorld dynamicsWorld;
+    GroundHeightField heights;
+
+    // Flat ground at z = 2, with a 5m high block at 101 < x < 121
+    btStaticPlaneShape groundShape{{0.f, 0.f, 1.f}, 2.f};
+    btBoxShape blockShape{{10.f, 10.f, 2.5f}};
+    std::unique_ptr<btRigidBody> ground;
+    std::unique_ptr<btRigidBody> block;
+
+    GroundFixture()
+        : collisionDispatcher{&collisionConfig}
+        , dynamicsWorld{&collisionDispatcher, &broadphase, &solver,
+                        &collisionConfig}
+        , heights{dynamicsWorld} {
+        ground = std::make_unique<btRigidBody>(
+            btRigidBody::btRigidBodyConstructionInfo{0.f, nullptr,
+                                                     &groundShape});
+        dynamicsWorld.addRigidBody(ground.get());
+
+        btTransform t;
+        t.setIdentity();
+        t.setOrigin({111.f, 0.f, 4.5f});
+        block = std::make_unique<btRigidBody>(
+            btRigidBody::btRigidBodyConstructionInfo{0.f, nullptr,
+                                                     &blockShape});
+        block->setWorldTransform(t);
+        dynamicsWorld.addRigidBody(block.get());
+    }
+
+    ~GroundFixture() {
+        dynamicsWorld.removeRigidBody(block.get());
+        dynamicsWorld.removeRigidBody(ground.get());
+    }
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(GroundHeightFieldTests)
+
+BOOST_FIXTURE_TEST_CASE(test_flat_ground, GroundFixture) {
+    const auto height = heights.getHeight({13.f, -7.f});
+    BOOST_REQUIRE(height.has_value());
+    BOOST_CHECK_CLOSE(*height, 2.f, 0.1f);
+    BOOST_CHECK_EQUAL(heights.getCellCount(), 1u);
+    BOOST_CHECK_EQUAL(heights.getSampleCount(), 4u);
+
+    // Further lookups between the same samples don't cast any rays
+    heights.getHeight({14.f, -5.f});
+    BOOST_CHECK_EQUAL(heights.getCellCount(), 1u);
+    BOOST_CHECK_EQUAL(heights.getSampleCount(), 4u);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_on_block, GroundFixture) {
+    const auto height = heights.getHeight({110.f, 1.f});
+    BOOST_REQUIRE(height.has_value());
+    BOOST_CHECK_CLOSE(*height, 7.f, 0.1f);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_block_edge_is_ambiguous, GroundFixture) {
+    BOOST_CHECK(!heights.getHeight({101.f, 1.f}).has_value());
+}
+
+BOOST_FIXTURE_TEST_CASE(test_invalidate, GroundFixture) {
+    heights.getHeight({2.f, 2.f});
+    heights.getHeight({110.f, 1.f});
+    BOOST_CHECK_EQUAL(heights.getSampleCount(), 8u);
+
+    // Only the samples under the area are taken again
+    heights.invalidate({100.f, -10.f}, {122.f, 10.f});
+    heights.getHeight({2.f, 2.f});
+    BOOST_CHECK_EQUAL(heights.getSampleCount(), 8u);
+    heights.getHeight({110.f, 1.f});
+    BOOST_CHECK_EQUAL(heights.getSampleCount(), 12u);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_clear, GroundFixture) {
+    heights.getHeight({0.f, 0.f});
+    BOOST_CHECK_NE(heights.getCellCount(), 0u);
+    heights.clear();
+    BOOST_CHECK_EQUAL(heights.getCellCount(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
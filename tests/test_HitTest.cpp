@@ -88,4 +88,34 @@ BOOST_FIXTURE_TEST_CASE(test_result_contains_object, WithSphere) {
     BOOST_CHECK_EQUAL(result[0].object, object);
 }
 
+BOOST_FIXTURE_TEST_CASE(test_result_buffer_is_replaced, WithSphere) {
+    HitTest::TestResult result;
+    hitTest.sphereTest({0.f, 0.f, 0.f}, 1.f, result);
+    BOOST_CHECK_EQUAL(result.size(), 1);
+
+    hitTest.sphereTest({10.f, 0.f, 0.f}, 1.f, result);
+    BOOST_CHECK(result.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(test_batch_results_per_test, WithSphere) {
+    const HitTest::Box boxes[] = {
+        {{0.f, 0.f, 0.f}, {0.01f, 0.01f, 0.01f}},
+        {{5.f, 0.f, 0.f}, {0.01f, 0.01f, 0.01f}},
+        {{0.f, 0.f, 1.f}, {1.f, 1.f, 1.f}},
+    };
+
+    HitTest::BatchResult result;
+    hitTest.boxTests(boxes, 3, result);
+    BOOST_REQUIRE_EQUAL(result.size(), 3);
+    BOOST_CHECK_EQUAL(result.end(0) - result.begin(0), 1);
+    BOOST_CHECK_EQUAL(result.end(1) - result.begin(1), 0);
+    BOOST_REQUIRE_EQUAL(result.end(2) - result.begin(2), 1);
+    BOOST_CHECK_EQUAL(result.begin(2)->body, target.get());
+
+    const HitTest::Sphere spheres[] = {{{5.f, 0.f, 0.f}, 1.f}};
+    hitTest.sphereTests(spheres, 1, result);
+    BOOST_REQUIRE_EQUAL(result.size(), 1);
+    BOOST_CHECK(result.begin(0) == result.end(0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
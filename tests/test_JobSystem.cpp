@@ -0,0 +1,79 @@
+#include <boost/test/unit_test.hpp>
+#include <core/JobSystem.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(JobSystemTests)
+
+BOOST_AUTO_TEST_CASE(test_parallel_for) {
+    for (auto workers : {0u, 3u}) {
+        JobSystem jobs(workers);
+        BOOST_CHECK_EQUAL(jobs.getWorkerCount(), workers);
+
+        std::vector<int> visits(1000, 0);
+        std::atomic<size_t> largest{0};
+        jobs.parallelFor(visits.size(), 16, [&](size_t begin, size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                visits[i]++;
+            }
+            auto size = largest.load();
+            while (end - begin > size &&
+                   !largest.compare_exchange_weak(size, end - begin)) {
+            }
+        });
+
+        BOOST_CHECK_EQUAL(largest.load(), 16u);
+        BOOST_CHECK_EQUAL(std::accumulate(visits.begin(), visits.end(), 0),
+                          1000);
+        BOOST_CHECK_EQUAL(
+            std::count(visits.begin(), visits.end(), 1), 1000);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_nested_jobs) {
+    JobSystem jobs(2);
+    std::atomic<int> total{0};
+
+    // Outer jobs wait on their own jobs without starving the pool
+    jobs.parallelFor(8, 1, [&](size_t, size_t) {
+        jobs.parallelFor(100, 10, [&](size_t begin, size_t end) {
+            total += static_cast<int>(end - begin);
+        });
+    });
+
+    BOOST_CHECK_EQUAL(total.load(), 800);
+}
+
+BOOST_AUTO_TEST_CASE(test_task_graph_order) {
+    for (auto workers : {0u, 3u}) {
+        JobSystem jobs(workers);
+
+        // a -> (b, c) -> d
+        std::atomic<int> step{0};
+        int a = -1, b = -1, c = -1, d = -1;
+        TaskGraph graph;
+        auto ta = graph.add([&] { a = step++; });
+        auto tb = graph.add([&] { b = step++; });
+        auto tc = graph.add([&] { c = step++; });
+        auto td = graph.add([&] { d = step++; });
+        graph.precede(ta, tb);
+        graph.precede(ta, tc);
+        graph.precede(tb, td);
+        graph.precede(tc, td);
+
+        for (auto run = 0; run < 2; ++run) {
+            step = 0;
+            jobs.run(graph);
+            BOOST_CHECK_EQUAL(step.load(), 4);
+            BOOST_CHECK_EQUAL(a, 0);
+            BOOST_CHECK_GT(b, a);
+            BOOST_CHECK_GT(c, a);
+            BOOST_CHECK_EQUAL(d, 3);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,6 @@
 #include <boost/test/unit_test.hpp>
 #include <data/Clump.hpp>
+#include <loaders/LoaderDFF.hpp>
 #include <platform/FileHandle.hpp>
 #include "test_Globals.hpp"
 
@@ -65,4 +66,26 @@ BOOST_AUTO_TEST_CASE(test_clump_clone) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_packed_positions_decode) {
+    std::vector<GeometryVertex> verts(3);
+    verts[0].position = {-2.f, 1.f, 0.5f};
+    verts[1].position = {3.f, 4.f, -1.5f};
+    verts[2].position = {0.25f, 2.5f, 0.f};
+
+    Geometry geom;
+    const auto packed = LoaderDFF::packVertices(geom, verts);
+    BOOST_REQUIRE(geom.quantizedPositions);
+    BOOST_REQUIRE_EQUAL(packed.size(), verts.size());
+
+    for (auto i = 0u; i < verts.size(); ++i) {
+        // Positions reach the shader normalized, as DrawBuffer sets them up
+        const auto normalized = glm::vec3(packed[i].position) / 65535.f;
+        const auto decoded =
+            glm::vec3(geom.positionTransform * glm::vec4(normalized, 1.f));
+        for (auto c = 0; c < 3; ++c) {
+            BOOST_CHECK_SMALL(decoded[c] - verts[i].position[c], 1e-3f);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,101 @@
+#include <boost/test/unit_test.hpp>
+#include <render/ParticleSystem.hpp>
+
+namespace {
+
+ParticleFX makeParticle(const glm::vec3& position, float lifetime) {
+    ParticleFX particle;
+    particle.position = position;
+    particle.starttime = 0.f;
+    particle.lifetime = lifetime;
+    return particle;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ParticleSystemTests)
+
+BOOST_AUTO_TEST_CASE(test_expired_particles_removed) {
+    ParticleSystem particles;
+    auto shortLived = particles.spawn(makeParticle({}, 1.f));
+    auto longLived = particles.spawn(makeParticle({}, 5.f));
+    auto forever = particles.spawn(makeParticle({}, -1.f));
+
+    particles.update(0.5f, 0.5f);
+    BOOST_CHECK_EQUAL(particles.size(), 3u);
+
+    particles.update(2.f, 1.5f);
+    BOOST_CHECK_EQUAL(particles.size(), 2u);
+    BOOST_CHECK(!particles.isAlive(shortLived));
+    BOOST_CHECK(particles.isAlive(longLived));
+
+    particles.update(10.f, 8.f);
+    BOOST_CHECK_EQUAL(particles.size(), 1u);
+    BOOST_CHECK(particles.isAlive(forever));
+}
+
+BOOST_AUTO_TEST_CASE(test_particles_moved) {
+    ParticleSystem particles;
+    auto particle = makeParticle({1.f, 0.f, 0.f}, -1.f);
+    particle.velocity = {0.f, 0.f, 2.f};
+    particles.spawn(particle);
+
+    particles.update(0.f, 0.5f);
+    const auto& position = particles.getPosition(0);
+    BOOST_CHECK_EQUAL(position.x, 1.f);
+    BOOST_CHECK_EQUAL(position.z, 1.f);
+}
+
+BOOST_AUTO_TEST_CASE(test_stale_handles_ignored) {
+    ParticleSystem particles;
+    auto first = particles.spawn(makeParticle({}, -1.f));
+    auto second = particles.spawn(makeParticle({}, -1.f));
+    particles.destroy(first);
+
+    // The slot of the first particle is reused
+    auto third = particles.spawn(makeParticle({}, -1.f));
+    BOOST_CHECK_EQUAL(third.slot, first.slot);
+    BOOST_CHECK(!particles.isAlive(first));
+
+    particles.destroy(first);
+    particles.setSize(first, {5.f, 5.f});
+    BOOST_CHECK_EQUAL(particles.size(), 2u);
+    BOOST_CHECK(particles.isAlive(second));
+    BOOST_CHECK(particles.isAlive(third));
+
+    // The second particle was moved into the first place
+    particles.setSize(second, {2.f, 3.f});
+    BOOST_CHECK_EQUAL(particles.getSize(0).y, 3.f);
+    BOOST_CHECK_EQUAL(particles.getSize(1).y, 1.f);
+}
+
+BOOST_AUTO_TEST_CASE(test_draw_order) {
+    ParticleSystem particles;
+    auto a = reinterpret_cast<TextureData*>(0x10);
+    auto b = reinterpret_cast<TextureData*>(0x20);
+
+    auto particle = makeParticle({1.f, 0.f, 0.f}, -1.f);
+    particle.texture = b;
+    particles.spawn(particle);
+    particle.position = {5.f, 0.f, 0.f};
+    particle.texture = a;
+    particles.spawn(particle);
+    particle.position = {3.f, 0.f, 0.f};
+    particle.texture = b;
+    particles.spawn(particle);
+    particle.position = {2.f, 0.f, 0.f};
+    particle.texture = a;
+    particles.spawn(particle);
+
+    std::vector<ParticleSystem::DrawKey> keys;
+    particles.buildDrawOrder({}, keys);
+    BOOST_REQUIRE_EQUAL(keys.size(), 4u);
+
+    // Grouped by texture, farthest first
+    BOOST_CHECK_EQUAL(keys[0].particle, 1u);
+    BOOST_CHECK_EQUAL(keys[1].particle, 3u);
+    BOOST_CHECK_EQUAL(keys[2].particle, 2u);
+    BOOST_CHECK_EQUAL(keys[3].particle, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
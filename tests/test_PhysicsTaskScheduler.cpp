@@ -0,0 +1,61 @@
+#include <boost/test/unit_test.hpp>
+#include <dynamics/PhysicsTaskScheduler.hpp>
+
+#ifdef RW_PHYSICS_MT
+
+#include <atomic>
+#include <vector>
+
+namespace {
+struct CountBody : btIParallelForBody {
+    std::vector<std::atomic<int>>* counts;
+
+    void forLoop(int iBegin, int iEnd) const override {
+        for (auto i = iBegin; i < iEnd; ++i) {
+            ++(*counts)[static_cast<size_t>(i)];
+        }
+    }
+};
+
+struct RangeSumBody : btIParallelSumBody {
+    btScalar sumLoop(int iBegin, int iEnd) const override {
+        return static_cast<btScalar>(iEnd - iBegin);
+    }
+};
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(PhysicsTaskSchedulerTests)
+
+BOOST_AUTO_TEST_CASE(test_thread_count) {
+    PhysicsTaskScheduler scheduler(4);
+    BOOST_CHECK_EQUAL(scheduler.getNumThreads(), 4);
+
+    scheduler.setNumThreads(0);
+    BOOST_CHECK_EQUAL(scheduler.getNumThreads(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_covers_range) {
+    PhysicsTaskScheduler scheduler(4);
+    std::vector<std::atomic<int>> counts(1000);
+    CountBody body;
+    body.counts = &counts;
+
+    for (auto i = 0; i < 100; ++i) {
+        scheduler.parallelFor(0, 1000, 7, body);
+    }
+
+    for (const auto& count : counts) {
+        BOOST_CHECK_EQUAL(count.load(), 100);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_sum) {
+    PhysicsTaskScheduler scheduler(3);
+    RangeSumBody body;
+
+    BOOST_CHECK_EQUAL(scheduler.parallelSum(10, 1010, 16, body), 1000.f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,156 @@
+#include <boost/test/unit_test.hpp>
+#include <ai/AIGraph.hpp>
+#include <ai/AIGraphNode.hpp>
+#include <ai/RoutePlanner.hpp>
+#include <data/PathData.hpp>
+
+#include <memory>
+
+namespace {
+
+/*
+ * d - e - f
+ * |       |
+ * a - b - c   g
+ */
+struct GraphFixture {
+    ai::AIGraph graph;
+    ai::AIGraphNode *a, *b, *c, *d, *e, *f, *g;
+
+    GraphFixture() {
+        a = addNode({0.f, 0.f, 0.f});
+        b = addNode({10.f, 0.f, 0.f});
+        c = addNode({20.f, 0.f, 0.f});
+        d = addNode({0.f, 10.f, 0.f});
+        e = addNode({10.f, 10.f, 0.f});
+        f = addNode({20.f, 10.f, 0.f});
+        g = addNode({40.f, 0.f, 0.f});
+        connect(a, b);
+        connect(b, c);
+        connect(a, d);
+        connect(d, e);
+        connect(e, f);
+        connect(f, c);
+    }
+
+    ai::AIGraphNode* addNode(const glm::vec3& position) {
+        auto node = std::make_unique<ai::AIGraphNode>();
+        node->type = ai::NodeType::Vehicle;
+        node->position = position;
+        node->disabled = false;
+        graph.nodes.push_back(std::move(node));
+        graph.revision++;
+        return graph.nodes.back().get();
+    }
+
+    void connect(ai::AIGraphNode* x, ai::AIGraphNode* y) {
+        x->connections.push_back(y);
+        y->connections.push_back(x);
+        graph.revision++;
+    }
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(RoutePlannerTests)
+
+BOOST_FIXTURE_TEST_CASE(test_shortest_route, GraphFixture) {
+    ai::RoutePlanner planner(graph);
+
+    auto route = planner.findRoute(a, c);
+    BOOST_REQUIRE(route);
+    BOOST_CHECK(route->complete);
+    const std::vector<ai::AIGraphNode*> expected{a, b, c};
+    BOOST_CHECK(route->nodes == expected);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_disabled_nodes_avoided, GraphFixture) {
+    ai::RoutePlanner planner(graph);
+    planner.findRoute(a, c);
+
+    b->disabled = true;
+    planner.invalidate();
+
+    auto route = planner.findRoute(a, c);
+    BOOST_REQUIRE(route);
+    BOOST_CHECK(route->complete);
+    const std::vector<ai::AIGraphNode*> expected{a, d, e, f, c};
+    BOOST_CHECK(route->nodes == expected);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_unreachable_goal, GraphFixture) {
+    ai::RoutePlanner planner(graph);
+
+    auto route = planner.findRoute(a, g);
+    BOOST_REQUIRE(route);
+    BOOST_CHECK(!route->complete);
+    BOOST_REQUIRE(!route->nodes.empty());
+    BOOST_CHECK_EQUAL(route->nodes.front(), a);
+    BOOST_CHECK_EQUAL(route->nodes.back(), c);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_routes_cached, GraphFixture) {
+    ai::RoutePlanner planner(graph);
+
+    auto first = planner.findRoute(a, c);
+    BOOST_CHECK_EQUAL(planner.getCachedRouteCount(), 1u);
+    BOOST_CHECK(planner.findRoute(a, c) == first);
+    BOOST_CHECK_EQUAL(planner.getCachedRouteCount(), 1u);
+
+    planner.findRoute(c, a);
+    BOOST_CHECK_EQUAL(planner.getCachedRouteCount(), 2u);
+
+    planner.invalidate();
+    BOOST_CHECK_EQUAL(planner.getCachedRouteCount(), 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_nearest_node, GraphFixture) {
+    ai::RoutePlanner planner(graph);
+
+    BOOST_CHECK_EQUAL(
+        planner.findNearestNode({9.f, 1.f, 0.f}, ai::NodeType::Vehicle), b);
+    BOOST_CHECK(planner.findNearestNode({9.f, 1.f, 0.f},
+                                        ai::NodeType::Pedestrian) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_linked_external_nodes_rebuild) {
+    ai::AIGraph graph;
+    ai::RoutePlanner planner(graph);
+    const glm::quat identity{1.0f, 0.0f, 0.0f, 0.0f};
+
+    PathData a{PathData::PATH_CAR,
+               0,
+               "",
+               {{PathNode::EXTERNAL, 1, {0.f, 0.f, 0.f}, 1.f, 0, 0},
+                {PathNode::EXTERNAL, -1, {20.f, 0.f, 0.f}, 1.f, 0, 0}}};
+    PathData b{PathData::PATH_CAR,
+               0,
+               "",
+               {{PathNode::EXTERNAL, 1, {20.f, 20.f, 0.f}, 1.f, 0, 0},
+                {PathNode::EXTERNAL, -1, {40.f, 20.f, 0.f}, 1.f, 0, 0}}};
+    graph.createPathNodes(glm::vec3(), identity, a);
+    graph.createPathNodes(glm::vec3(), identity, b);
+    BOOST_REQUIRE_EQUAL(graph.nodes.size(), 4u);
+
+    auto start = graph.nodes[0].get();
+    auto goal = graph.nodes[3].get();
+    auto route = planner.findRoute(start, goal);
+    BOOST_REQUIRE(route);
+    BOOST_CHECK(!route->complete);
+
+    // Joins the two paths without adding any nodes
+    PathData link{PathData::PATH_CAR,
+                  0,
+                  "",
+                  {{PathNode::EXTERNAL, 1, {20.f, 0.f, 0.f}, 1.f, 0, 0},
+                   {PathNode::EXTERNAL, -1, {20.f, 20.f, 0.f}, 1.f, 0, 0}}};
+    graph.createPathNodes(glm::vec3(), identity, link);
+    BOOST_REQUIRE_EQUAL(graph.nodes.size(), 4u);
+
+    route = planner.findRoute(start, goal);
+    BOOST_REQUIRE(route);
+    BOOST_CHECK(route->complete);
+    BOOST_CHECK_EQUAL(route->nodes.size(), 4u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
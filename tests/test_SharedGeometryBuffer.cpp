@@ -0,0 +1,38 @@
+#include <boost/test/unit_test.hpp>
+#include <gl/SharedGeometryBuffer.hpp>
+
+BOOST_AUTO_TEST_SUITE(SharedGeometryBufferTests)
+
+BOOST_AUTO_TEST_CASE(test_range_allocate) {
+    BufferRangeAllocator allocator(100);
+
+    auto a = allocator.allocate(40);
+    auto b = allocator.allocate(40);
+    BOOST_REQUIRE(a);
+    BOOST_REQUIRE(b);
+    BOOST_CHECK_EQUAL(*a, 0u);
+    BOOST_CHECK_EQUAL(*b, 40u);
+    BOOST_CHECK_EQUAL(allocator.getFreeSize(), 20u);
+
+    BOOST_CHECK(!allocator.allocate(30));
+}
+
+BOOST_AUTO_TEST_CASE(test_range_free_merges) {
+    BufferRangeAllocator allocator(90);
+
+    auto a = allocator.allocate(30);
+    auto b = allocator.allocate(30);
+    auto c = allocator.allocate(30);
+    BOOST_REQUIRE(a && b && c);
+
+    allocator.free(*a, 30);
+    allocator.free(*c, 30);
+    BOOST_CHECK(!allocator.allocate(60));
+
+    allocator.free(*b, 30);
+    auto d = allocator.allocate(90);
+    BOOST_REQUIRE(d);
+    BOOST_CHECK_EQUAL(*d, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,55 @@
+#include <boost/test/unit_test.hpp>
+#include <gl/StreamBuffer.hpp>
+
+BOOST_AUTO_TEST_SUITE(StreamBufferTests)
+
+BOOST_AUTO_TEST_CASE(test_region_allocate_aligned) {
+    StreamRegionAllocator regions(300, 3);
+    BOOST_CHECK_EQUAL(regions.getRegionSize(), 100u);
+
+    auto a = regions.allocate(10, 4);
+    auto b = regions.allocate(12, 12);
+    BOOST_REQUIRE(a);
+    BOOST_REQUIRE(b);
+    BOOST_CHECK_EQUAL(*a, 0u);
+    BOOST_CHECK_EQUAL(*b, 12u);
+
+    // Only 76 bytes remain in the region
+    BOOST_CHECK(!regions.allocate(80, 4));
+    BOOST_CHECK(!regions.isRegionEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(test_region_advance) {
+    StreamRegionAllocator regions(300, 3);
+
+    BOOST_REQUIRE(regions.allocate(90, 1));
+    BOOST_CHECK_EQUAL(regions.advance(), 1u);
+    BOOST_CHECK(regions.isRegionEmpty());
+
+    // Alignment is relative to the start of the buffer
+    auto a = regions.allocate(36, 36);
+    BOOST_REQUIRE(a);
+    BOOST_CHECK_EQUAL(*a, 108u);
+    BOOST_CHECK_EQUAL(*a % 36, 0u);
+    BOOST_CHECK(!regions.allocate(72, 36));
+
+    regions.advance();
+    BOOST_CHECK_EQUAL(regions.advance(), 0u);
+    auto b = regions.allocate(100, 1);
+    BOOST_REQUIRE(b);
+    BOOST_CHECK_EQUAL(*b, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_region_max_count) {
+    StreamRegionAllocator regions(300, 3);
+    const auto count = regions.getMaxCount(36);
+    BOOST_CHECK_EQUAL(count, 1u);
+
+    // The largest allocation fits whatever the alignment of the region
+    for (auto i = 0u; i < regions.getRegionCount(); ++i) {
+        BOOST_CHECK(regions.allocate(count * 36, 36));
+        regions.advance();
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
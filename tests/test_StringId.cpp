@@ -0,0 +1,52 @@
+#include <boost/test/unit_test.hpp>
+#include <rw/StringId.hpp>
+
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+BOOST_AUTO_TEST_SUITE(StringIdTests)
+
+BOOST_AUTO_TEST_CASE(test_literals_match_runtime) {
+    static_assert("radar_centre"_sid == StringId("radar_centre"),
+                  "Literals should be hashed at compile time");
+
+    const std::string name = "radar_centre";
+    BOOST_CHECK(StringId(name) == "radar_centre"_sid);
+    BOOST_CHECK(StringId(name) != "radar_north"_sid);
+    BOOST_CHECK(StringId() == StringId(""));
+
+    static_assert(!std::is_convertible_v<const char*, StringId> &&
+                      !std::is_convertible_v<std::string, NameId>,
+                  "Strings should only be hashed explicitly");
+}
+
+BOOST_AUTO_TEST_CASE(test_case_insensitive) {
+    BOOST_CHECK(NameId("Player") == "player"_nid);
+    BOOST_CHECK(NameId(std::string("HUD")) == "hud"_nid);
+    BOOST_CHECK(StringId("Player") != "player"_sid);
+}
+
+BOOST_AUTO_TEST_CASE(test_interned_strings) {
+    auto id = StringId::intern("EnterVehicle");
+    BOOST_CHECK(id == "EnterVehicle"_sid);
+    BOOST_CHECK_EQUAL(id.str(), "EnterVehicle");
+
+    // The first spelling interned is kept
+    NameId::intern("Coronastar");
+    BOOST_CHECK_EQUAL("coronastar"_nid.str(), "Coronastar");
+
+    BOOST_CHECK_EQUAL("never_interned"_sid.str().front(), '#');
+}
+
+BOOST_AUTO_TEST_CASE(test_map_keys) {
+    std::unordered_map<NameId, int> slots;
+    slots[NameId::intern("particle")] = 1;
+    slots[NameId::intern("hud")] = 2;
+
+    BOOST_CHECK_EQUAL(slots.count("PARTICLE"_nid), 1u);
+    BOOST_CHECK_EQUAL(slots["hud"_nid], 2);
+    BOOST_CHECK_EQUAL(slots.count("fonts"_nid), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
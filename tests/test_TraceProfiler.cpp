@@ -0,0 +1,81 @@
+#include <boost/test/unit_test.hpp>
+#include <core/TraceProfiler.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+namespace {
+
+std::string writeTrace() {
+    const auto path =
+        (std::filesystem::temp_directory_path() / "rw-trace-test.json")
+            .string();
+    BOOST_REQUIRE(TraceProfiler::write(path));
+
+    std::ifstream file(path);
+    std::string trace{std::istreambuf_iterator<char>(file),
+                      std::istreambuf_iterator<char>()};
+    std::filesystem::remove(path);
+    return trace;
+}
+
+size_t count(const std::string& trace, const std::string& text) {
+    size_t n = 0;
+    for (auto p = trace.find(text); p != std::string::npos;
+         p = trace.find(text, p + 1)) {
+        n++;
+    }
+    return n;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TraceProfilerTests)
+
+BOOST_AUTO_TEST_CASE(test_scopes_recorded) {
+    TraceProfiler::clear();
+    {
+        TraceProfiler::Scope outer("Outer");
+        TraceProfiler::Scope inner("Inner");
+    }
+    TraceProfiler::frameBoundary();
+
+    const auto trace = writeTrace();
+    BOOST_CHECK_EQUAL(trace.rfind("{\"traceEvents\":[", 0), 0u);
+    BOOST_CHECK_EQUAL(count(trace, "\"ph\":\"B\""), 2u);
+    BOOST_CHECK_EQUAL(count(trace, "\"ph\":\"E\""), 2u);
+    BOOST_CHECK(trace.find("\"name\":\"Outer\"") <
+                trace.find("\"name\":\"Inner\""));
+    BOOST_CHECK_EQUAL(count(trace, "\"name\":\"Frame\""), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_counters_accumulate) {
+    TraceProfiler::clear();
+    TraceProfiler::setCounter("Objects", 5);
+    TraceProfiler::addCounter("Objects", 2);
+
+    const auto trace = writeTrace();
+    BOOST_CHECK_EQUAL(count(trace, "\"ph\":\"C\""), 2u);
+    BOOST_CHECK_EQUAL(count(trace, "{\"value\":5}"), 1u);
+    BOOST_CHECK_EQUAL(count(trace, "{\"value\":7}"), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_threads_named) {
+    TraceProfiler::clear();
+    std::thread worker([] {
+        TraceProfiler::setThreadName("Worker \"1\"");
+        TraceProfiler::timelineEnter("Loading");
+        TraceProfiler::timelineLeave("Loading");
+    });
+    worker.join();
+
+    // Events of finished threads are kept
+    const auto trace = writeTrace();
+    BOOST_CHECK_EQUAL(count(trace, "\"name\":\"Worker \\\"1\\\"\""), 1u);
+    BOOST_CHECK_EQUAL(count(trace, "\"id\":\"Loading\""), 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,6 @@
 #include <boost/test/unit_test.hpp>
 #include <data/Clump.hpp>
+#include <dynamics/CollisionInstance.hpp>
 #include <objects/VehicleObject.hpp>
 #include "test_Globals.hpp"
 
@@ -130,4 +131,31 @@ BOOST_AUTO_TEST_CASE(test_open_part) {
     Global::get().e->destroyObject(vehicle);
 }
 
+BOOST_AUTO_TEST_CASE(test_physics_lod) {
+    VehicleObject* vehicle = Global::get().e->createVehicle(
+        90u, glm::vec3(10.f, 0.f, 0.f), glm::quat{1.0f,0.0f,0.0f,0.0f});
+
+    BOOST_REQUIRE(vehicle);
+    BOOST_CHECK(vehicle->getPhysicsLOD() == PhysicsLOD::Full);
+
+    vehicle->setPhysicsLOD(PhysicsLOD::Kinematic);
+    BOOST_CHECK(vehicle->getPhysicsLOD() == PhysicsLOD::Kinematic);
+    BOOST_CHECK(vehicle->collision->getBulletBody()->isKinematicObject());
+
+    // Kinematic vehicles drive straight to their path target
+    vehicle->setPathTarget(glm::vec3(10.f, 10.f, 0.f), 5.f);
+    vehicle->tickPhysics(1.f);
+    BOOST_CHECK_CLOSE(vehicle->getPosition().y, 5.f, 0.1f);
+    BOOST_CHECK_CLOSE(vehicle->getVelocity(), 5.f, 0.1f);
+
+    vehicle->setPhysicsLOD(PhysicsLOD::Disabled);
+    BOOST_CHECK(!vehicle->collision->getBulletBody()->isInWorld());
+
+    vehicle->setPhysicsLOD(PhysicsLOD::Full);
+    BOOST_CHECK(vehicle->collision->getBulletBody()->isInWorld());
+    BOOST_CHECK(!vehicle->collision->getBulletBody()->isKinematicObject());
+
+    Global::get().e->destroyObject(vehicle);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -2,6 +2,9 @@
 #include "test_Globals.hpp"
 #include <render/ViewCamera.hpp>
 
+#include <chrono>
+#include <random>
+
 namespace {
 
 struct CameraFixture {
@@ -9,6 +12,18 @@ struct CameraFixture {
         {1.f, 2.f, 3.f}
     };
 };
+
+ViewFrustum::SphereBatch randomSpheres(size_t count) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> coord(-200.f, 200.f);
+    std::uniform_real_distribution<float> radius(0.f, 20.f);
+
+    ViewFrustum::SphereBatch batch;
+    for (auto i = 0u; i < count; ++i) {
+        batch.add({coord(rng), coord(rng), coord(rng)}, radius(rng));
+    }
+    return batch;
+}
 }
 
 BOOST_AUTO_TEST_SUITE(ViewCameraTests)
@@ -22,5 +37,51 @@ BOOST_FIXTURE_TEST_CASE(test_view_matrix, CameraFixture) {
     BOOST_CHECK_EQUAL(view[3], glm::vec4(2.f, -3.f, 1.f, 1.f));
 }
 
+BOOST_FIXTURE_TEST_CASE(test_frustum_batch, CameraFixture) {
+    camera_.frustum.update(camera_.frustum.projection() * camera_.getView());
+
+    // Not a multiple of the SIMD width, to cover the scalar tail
+    auto batch = randomSpheres(1001);
+    camera_.frustum.intersects(batch);
+
+    for (auto i = 0u; i < batch.size(); ++i) {
+        const glm::vec3 center{batch.x[i], batch.y[i], batch.z[i]};
+        BOOST_CHECK_EQUAL(batch.isVisible(i),
+                          camera_.frustum.intersects(center, batch.radius[i]));
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(benchmark_frustum_batch, CameraFixture *
+                        boost::unit_test_framework::label("benchmark") *
+                        boost::unit_test_framework::disabled()) {
+    using Clock = std::chrono::steady_clock;
+    constexpr size_t kSpheres = 1 << 16;
+    constexpr int kRepeats = 200;
+
+    camera_.frustum.update(camera_.frustum.projection() * camera_.getView());
+    auto batch = randomSpheres(kSpheres);
+
+    auto start = Clock::now();
+    size_t visible = 0;
+    for (auto r = 0; r < kRepeats; ++r) {
+        for (auto i = 0u; i < kSpheres; ++i) {
+            const glm::vec3 center{batch.x[i], batch.y[i], batch.z[i]};
+            visible += camera_.frustum.intersects(center, batch.radius[i]);
+        }
+    }
+    const std::chrono::duration<double> scalar = Clock::now() - start;
+
+    start = Clock::now();
+    for (auto r = 0; r < kRepeats; ++r) {
+        camera_.frustum.intersects(batch);
+        visible += batch.mask[0];
+    }
+    const std::chrono::duration<double> batched = Clock::now() - start;
+
+    const double total = static_cast<double>(kSpheres) * kRepeats;
+    BOOST_TEST_MESSAGE("Scalar: " << total / scalar.count() << " spheres/s");
+    BOOST_TEST_MESSAGE("Batch:  " << total / batched.count() << " spheres/s");
+    BOOST_CHECK(visible > 0);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
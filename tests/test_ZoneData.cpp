@@ -1,5 +1,6 @@
 #include <boost/test/unit_test.hpp>
 #include <data/ZoneData.hpp>
+#include <data/ZoneGrid.hpp>
 #include "test_Globals.hpp"
 
 BOOST_AUTO_TEST_SUITE(ZoneDataTests)
@@ -30,4 +31,35 @@ BOOST_AUTO_TEST_CASE(test_hierarchy) {
     BOOST_CHECK_EQUAL(zone.findLeafAtPoint({ 5.f, 5.f, 0.f}), &leaf);
 
 }
+
+BOOST_AUTO_TEST_CASE(test_grid_matches_hierarchy) {
+    ZoneDataList zones{
+        {"ROOT", 0, {-1000.f, -1000.f, -50.f}, {1000.f, 1000.f, 50.f}, 0, 0, 0},
+        {"A", 0, {-800.f, -800.f, -50.f}, {0.f, 0.f, 50.f}, 0, 0, 0},
+        {"A1", 0, {-500.f, -500.f, -50.f}, {-250.f, -250.f, 50.f}, 0, 0, 0},
+        {"A2", 0, {-300.f, -300.f, -10.f}, {-100.f, -100.f, 10.f}, 0, 0, 0},
+        {"B", 0, {-50.f, -50.f, -50.f}, {650.f, 420.f, 50.f}, 0, 0, 0},
+        {"B1", 0, {100.f, 100.f, -50.f}, {150.f, 150.f, 50.f}, 0, 0, 0},
+        {"C", 0, {-1200.f, 500.f, -50.f}, {-900.f, 700.f, 50.f}, 0, 0, 0},
+    };
+    for (auto& zone : zones) {
+        if (&zone != &zones[0]) {
+            zones[0].insertZone(zone);
+        }
+    }
+
+    ZoneGrid grid;
+    grid.build(zones[0]);
+
+    for (float x = -1100.f; x <= 1100.f; x += 12.5f) {
+        for (float y = -1100.f; y <= 1100.f; y += 12.5f) {
+            for (float z : {0.f, 20.f, 60.f}) {
+                const glm::vec3 point{x, y, z};
+                BOOST_CHECK_EQUAL(grid.findZoneAt(point),
+                                  zones[0].findLeafAtPoint(point));
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()